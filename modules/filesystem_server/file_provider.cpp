@@ -33,6 +33,12 @@ Ref<Resource> FileProvider::_load(const String &p_path, const String &p_type_hin
 	return res;
 }
 
+void FileProvider::_files_changed() {
+	if (FileSystemServer::get_singleton()) {
+		FileSystemServer::get_singleton()->_provider_files_changed(this);
+	}
+}
+
 String FileProvider::get_resource_type(const String &p_path) const {
 	return FileSystemServer::get_singleton()->get_resource_type(p_path, Ref<FileProvider>(this));
 }
@@ -25,6 +25,9 @@ protected:
 
 	String source;
 
+	// To be called once `get_files()` changed, so the FileSystemServer can update its path index.
+	void _files_changed();
+
 public:
 	virtual Ref<FileAccess> open(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error = nullptr) const = 0;
 	Ref<FileAccess> _open(const String &p_path, FileAccess::ModeFlags p_mode_flags) const;
@@ -35,6 +38,9 @@ public:
 	virtual PackedStringArray get_files() const { return {}; }
 	virtual bool has_file(const String &p_path) const = 0;
 
+	// False for providers that open paths missing from `get_files()`, the FileSystemServer tries them on every open.
+	virtual bool is_indexable() const { return true; }
+
 	virtual String get_source() const { return source; }
 
 	String get_resource_type(const String &p_path) const;
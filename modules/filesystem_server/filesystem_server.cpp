@@ -17,32 +17,105 @@ thread_local Error FileSystemServer::last_file_open_error = OK;
 
 FileSystemServer *FileSystemServer::singleton = nullptr;
 
-Ref<FileAccess> FileSystemServer::open(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error) const {
-	Ref<FileAccess> f;
+#define PATH_MISSES_MAX 4096
 
+Ref<FileAccess> FileSystemServer::open(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error) const {
 	if (current_provider.is_valid()) {
 		return current_provider->open(p_path, p_mode_flags, r_error);
 	}
 
-	if (PackedData::get_singleton()->is_disabled()) {
+	if (p_mode_flags == FileAccess::READ) {
+		return _open_routed(p_path, p_mode_flags, r_error);
+	}
+
+	Ref<FileAccess> f = _open_routed(p_path, p_mode_flags, r_error);
+	// The file may exist now: a miss recorded meanwhile is erased, one still being looked up has an older version and is dropped.
+	MutexLock lock(path_index_mutex);
+	path_misses.erase(p_path);
+	path_index_version++;
+	return f;
+}
+
+Ref<FileAccess> FileSystemServer::_open_routed(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error) const {
+	Ref<FileAccess> f;
+
+	bool packed_disabled = PackedData::get_singleton()->is_disabled();
+	if (packed_disabled) {
 		f = open_internal(p_path, p_mode_flags, r_error);
 		if (f.is_valid()) {
 			return f;
 		}
 	}
 
-	for (int i = 0; i < provider_list.size(); i++) {
-		f = provider_list[i]->open(p_path, p_mode_flags, r_error);
-		if (f.is_valid()) {
-			return f;
+	bool read_only = p_mode_flags == FileAccess::READ;
+	Ref<FileProvider> owner;
+	uint32_t version;
+	{
+		MutexLock lock(path_index_mutex);
+		if (path_index_dirty) {
+			_rebuild_path_index();
+		}
+		if (read_only && path_misses.has(p_path)) {
+			if (r_error) {
+				*r_error = ERR_FILE_NOT_FOUND;
+			}
+			return Ref<FileAccess>();
+		}
+		const Ref<FileProvider> *E = path_index.getptr(p_path);
+		if (E) {
+			owner = *E;
+		}
+		version = path_index_version;
+	}
+
+	if (unindexed_provider_count == 0) {
+		if (owner.is_valid()) {
+			f = owner->open(p_path, p_mode_flags, r_error);
+			if (f.is_valid()) {
+				return f;
+			}
+			// A listed file can still fail to open, as a remap to a missing file: the next providers get their turn.
+			for (int i = provider_list.find(owner) + 1; i < provider_list.size(); i++) {
+				f = provider_list[i]->open(p_path, p_mode_flags, r_error);
+				if (f.is_valid()) {
+					return f;
+				}
+			}
+		}
+	} else {
+		// Indexable providers only open what they list, the ones before the owner can be skipped.
+		bool owner_reached = false;
+		for (int i = 0; i < provider_list.size(); i++) {
+			const Ref<FileProvider> &provider = provider_list[i];
+			if (provider == owner) {
+				owner_reached = true;
+			} else if (!owner_reached && provider->is_indexable()) {
+				continue;
+			}
+			f = provider->open(p_path, p_mode_flags, r_error);
+			if (f.is_valid()) {
+				return f;
+			}
 		}
 	}
 
-	if (!PackedData::get_singleton()->is_disabled()) {
+	if (!packed_disabled) {
 		f = open_internal(p_path, p_mode_flags, r_error);
 		if (f.is_valid()) {
 			return f;
 		}
+
+		// Without PackedData the OS files are the project ones, which change while running: misses are not kept.
+		// Only `res://` is answered by the packs and the providers, `user://` and absolute paths are OS files which can appear at any time.
+		if (read_only && p_path.begins_with("res://")) {
+			MutexLock lock(path_index_mutex);
+			if (version == path_index_version) {
+				if (path_misses.size() >= PATH_MISSES_MAX) {
+					path_misses.clear();
+				}
+				path_misses.insert(p_path);
+			}
+		}
 	}
 
 	return Ref<FileAccess>();
@@ -175,13 +248,30 @@ int FileSystemServer::add_provider(const Ref<FileProvider> &p_provider) {
 		ERR_FAIL_COND_V(!p_provider->get_source().is_empty() && added_provider->get_source() == p_provider->get_source(), -1);
 	}
 	provider_list.push_back(p_provider);
+	if (p_provider->is_indexable()) {
+		MutexLock lock(path_index_mutex);
+		// Last in the list, it only gets the paths no other provider has.
+		if (!path_index_dirty) {
+			_index_provider(p_provider);
+		}
+		path_misses.clear();
+		path_index_version++;
+	} else {
+		unindexed_provider_count++;
+	}
 
 	const_cast<FileProvider *>(p_provider.ptr())->on_added_to_filesystem_server();
 	return provider_list.size() - 1;
 }
 
 void FileSystemServer::remove_provider(const Ref<FileProvider> &p_provider) {
-	provider_list.erase(p_provider);
+	if (provider_list.erase(p_provider)) {
+		if (p_provider->is_indexable()) {
+			_reindex_paths(p_provider->get_files());
+		} else {
+			unindexed_provider_count--;
+		}
+	}
 	if (p_provider.is_valid()) {
 		const_cast<FileProvider *>(p_provider.ptr())->on_removed_to_filesystem_server();
 	}
@@ -215,6 +305,69 @@ void FileSystemServer::move_provider(const Ref<FileProvider> &p_provider, int p_
 	ERR_FAIL_INDEX_MSG(p_to_index, provider_list.size(), "Invalid index.");
 	provider_list.remove_at(from);
 	provider_list.insert(p_to_index, p_provider);
+	if (p_provider->is_indexable()) {
+		_reindex_paths(p_provider->get_files());
+	}
+}
+
+void FileSystemServer::_provider_files_changed(const FileProvider *p_provider) {
+	for (const Ref<FileProvider> &provider : provider_list) {
+		if (provider.ptr() == p_provider) {
+			// Changes come in batches, as remaps being added one by one: the index is rebuilt on the next open.
+			MutexLock lock(path_index_mutex);
+			path_index_dirty = true;
+			path_misses.clear();
+			path_index_version++;
+			return;
+		}
+	}
+}
+
+void FileSystemServer::_index_provider(const Ref<FileProvider> &p_provider) const {
+	PackedStringArray files = p_provider->get_files();
+	for (const String &file : files) {
+		if (!path_index.has(file)) {
+			path_index.insert(file, p_provider);
+		}
+	}
+}
+
+// Gives `p_paths` back to the first provider listing them, from the providers' own lists rather than `has_file()` which hashes every path.
+void FileSystemServer::_reindex_paths(const PackedStringArray &p_paths) {
+	MutexLock lock(path_index_mutex);
+	path_misses.clear();
+	path_index_version++;
+	if (path_index_dirty) {
+		return;
+	}
+
+	HashSet<String> pending;
+	for (const String &path : p_paths) {
+		path_index.erase(path);
+		pending.insert(path);
+	}
+	for (int i = 0; i < provider_list.size() && !pending.is_empty(); i++) {
+		const Ref<FileProvider> &provider = provider_list[i];
+		if (!provider->is_indexable()) {
+			continue;
+		}
+		PackedStringArray files = provider->get_files();
+		for (const String &file : files) {
+			if (pending.erase(file)) {
+				path_index.insert(file, provider);
+			}
+		}
+	}
+}
+
+void FileSystemServer::_rebuild_path_index() const {
+	path_index.clear();
+	for (const Ref<FileProvider> &provider : provider_list) {
+		if (provider->is_indexable()) {
+			_index_provider(provider);
+		}
+	}
+	path_index_dirty = false;
 }
 
 Ref<FileAccess> FileSystemServer::get_os_file_access() const {
@@ -7,6 +7,9 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "file_provider.h"
 
 class FileSystemServer : public Object {
@@ -22,6 +25,21 @@ protected:
 	List<Ref<FileProvider>> current_provider_stack;
 	Ref<FileProvider> current_provider;
 
+	// Every path listed by an indexable provider, to the first of them in `provider_list`.
+	mutable HashMap<String, Ref<FileProvider>> path_index;
+	// `res://` paths opened for reading that neither a provider nor the OS had, only kept while PackedData is enabled.
+	mutable HashSet<String> path_misses;
+	mutable bool path_index_dirty = false;
+	mutable uint32_t path_index_version = 0;
+	mutable Mutex path_index_mutex;
+	int unindexed_provider_count = 0;
+
+	void _index_provider(const Ref<FileProvider> &p_provider) const;
+	void _reindex_paths(const PackedStringArray &p_paths);
+	void _rebuild_path_index() const;
+	// Opens from the providers, the index and the OS, see `open`.
+	Ref<FileAccess> _open_routed(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error) const;
+
 public:
 	Ref<FileAccess> open(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error = nullptr) const;
 	Ref<FileAccess> open_internal(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error = nullptr) const;
@@ -43,6 +61,7 @@ public:
 	Ref<FileProvider> get_provider_by_source(const String &p_source) const;
 	bool has_provider(const Ref<FileProvider> &p_provider) const;
 	void move_provider(const Ref<FileProvider> &p_provider, int p_to_index);
+	void _provider_files_changed(const FileProvider *p_provider);
 
 	Ref<FileAccess> get_os_file_access() const;
 
@@ -65,4 +84,5 @@ public:
 		return FileSystemServer::get_singleton()->open_internal(p_path, p_mode_flags, r_error);
 	}
 	virtual bool has_file(const String &p_path) const override { return false; }
+	virtual bool is_indexable() const override { return false; }
 };
@@ -71,6 +71,7 @@ bool FileProviderPack::load_pack(const String &p_path) {
 	}
 
 	source = p_path;
+	_files_changed();
 
 	return true;
 }
@@ -170,6 +171,7 @@ void FileProviderPack::clear() {
 	file_list.clear();
 	project_environment = Ref<ProjectEnvironment>();
 	source = "";
+	_files_changed();
 }
 
 void FileProviderPack::_bind_methods() {
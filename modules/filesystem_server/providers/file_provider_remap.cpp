@@ -14,7 +14,11 @@ void FileProviderRemap::add_remap(const String &p_path, const String &p_to) {
 }
 
 void FileProviderRemap::add_provider_remap(const String &p_path, const Ref<FileProvider> &p_provider, const String &p_to) {
+	bool added = !remaps.has(p_path);
 	remaps[p_path] = Remap{ p_path, p_to, p_provider };
+	if (added) {
+		_files_changed();
+	}
 }
 
 bool FileProviderRemap::has_remap(const String &p_path) const {
@@ -22,7 +26,11 @@ bool FileProviderRemap::has_remap(const String &p_path) const {
 }
 
 bool FileProviderRemap::remove_remap(const String &p_from) {
-	return remaps.erase(p_from);
+	if (!remaps.erase(p_from)) {
+		return false;
+	}
+	_files_changed();
+	return true;
 }
 
 Ref<FileAccess> FileProviderRemap::open(const String &p_path, FileAccess::ModeFlags p_mode_flags, Error *r_error) const {
@@ -0,0 +1,270 @@
+/**
+ * gles3_benchmark.cpp
+ *
+ * This file is part of Spike engine, a modification and extension of Godot.
+ *
+ */
+#include "gles3_benchmark.h"
+
+#if defined(GLES3_ENABLED) && defined(TOOLS_ENABLED)
+
+#include "core/math/random_pcg.h"
+#include "core/os/os.h"
+#include "core/templates/sort_array.h"
+#include "rasterizer_scene_gles3.h"
+#include "scene/main/window.h"
+#include "servers/rendering_server.h"
+#include "storage/radix_sort.h"
+#include "storage/utilities.h"
+
+#define GLES3_BENCHMARK_DEFAULT_FRAMES 300
+#define GLES3_BENCHMARK_WARMUP_FRAMES 30
+#define GLES3_BENCHMARK_GRID_WIDTH 200
+#define GLES3_BENCHMARK_GRID_HEIGHT 100
+#define GLES3_BENCHMARK_INSTANCES (GLES3_BENCHMARK_GRID_WIDTH * GLES3_BENCHMARK_GRID_HEIGHT)
+#define GLES3_BENCHMARK_SORT_ELEMENTS 2000000 // Sorted per case, in lists of 1k, 10k or 100k.
+
+// Stands for a render list element: two halves of a 128-bit sort key and a view depth.
+struct GLES3BenchmarkElement {
+	uint64_t key1 = 0;
+	uint64_t key2 = 0;
+	float depth = 0;
+};
+
+struct GLES3BenchmarkSortByKey {
+	_FORCE_INLINE_ bool operator()(const GLES3BenchmarkElement *A, const GLES3BenchmarkElement *B) const {
+		return (A->key2 == B->key2) ? (A->key1 < B->key1) : (A->key2 < B->key2);
+	}
+};
+
+struct GLES3BenchmarkSortByDepth {
+	_FORCE_INLINE_ bool operator()(const GLES3BenchmarkElement *A, const GLES3BenchmarkElement *B) const {
+		return A->depth < B->depth;
+	}
+};
+
+int GLES3Benchmark::get_requested_frames() {
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const String &arg : args) {
+		if (arg == GLES3_BENCHMARK_ARG) {
+			return GLES3_BENCHMARK_DEFAULT_FRAMES;
+		}
+		if (arg.begins_with(GLES3_BENCHMARK_ARG "=")) {
+			int frames = arg.get_slice("=", 1).to_int();
+			return frames > 0 ? frames : GLES3_BENCHMARK_DEFAULT_FRAMES;
+		}
+	}
+	return 0;
+}
+
+void GLES3Benchmark::_report(const String &p_name, double p_value, const char *p_unit) {
+	print_line(vformat("%s%s %s", p_name.rpad(32), String::num(p_value, 1).lpad(10), p_unit));
+}
+
+// Sorts the same lists as RenderList::sort_by_key (128-bit keys) and the particle view depth ordering (float depths),
+// with SortArray then with RadixSort the way those call sites use it, and reports the time per sort.
+void GLES3Benchmark::_run_sort_cases() {
+	RandomPCG rng(1234);
+	LocalVector<GLES3BenchmarkElement> source;
+	source.resize(100000);
+	for (GLES3BenchmarkElement &e : source) {
+		// Render keys only use some of their bits, as the real ones built from shader, material and surface ids.
+		e.key1 = (uint64_t(rng.rand() & 0xFFFF) << 32) | rng.rand();
+		e.key2 = uint64_t(rng.rand() & 0xFF) << 40;
+		e.depth = rng.randf_range(0.05, 1000.0);
+	}
+
+	LocalVector<GLES3BenchmarkElement *> elements;
+	LocalVector<GLES3BenchmarkElement *> tmp_elements;
+	LocalVector<uint64_t> keys;
+	LocalVector<uint64_t> tmp_keys;
+	LocalVector<uint32_t> depth_keys;
+	LocalVector<uint32_t> tmp_depth_keys;
+
+	static const uint32_t sizes[] = { 1000, 10000, 100000 };
+	for (uint32_t size : sizes) {
+		uint32_t rounds = MAX(GLES3_BENCHMARK_SORT_ELEMENTS / size, 1u);
+		elements.resize(size);
+		keys.resize(size);
+		depth_keys.resize(size);
+		uint64_t sort_array_key_usec = 0;
+		uint64_t radix_key_usec = 0;
+		uint64_t sort_array_depth_usec = 0;
+		uint64_t radix_depth_usec = 0;
+		bool sorted = true;
+
+		for (uint32_t r = 0; r < rounds; r++) {
+			// Every round sorts another window of the source, in its original order.
+			uint32_t from = (r * 7919) % (source.size() - size + 1);
+
+			for (uint32_t i = 0; i < size; i++) {
+				elements[i] = &source[from + i];
+			}
+			uint64_t begin = OS::get_singleton()->get_ticks_usec();
+			SortArray<GLES3BenchmarkElement *, GLES3BenchmarkSortByKey> key_sorter;
+			key_sorter.sort(elements.ptr(), size);
+			sort_array_key_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			for (uint32_t i = 0; i < size; i++) {
+				elements[i] = &source[from + i];
+			}
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < size; i++) {
+				keys[i] = elements[i]->key1;
+			}
+			OPENGL3::RadixSort::sort(keys.ptr(), elements.ptr(), size, tmp_keys, tmp_elements);
+			for (uint32_t i = 0; i < size; i++) {
+				keys[i] = elements[i]->key2;
+			}
+			OPENGL3::RadixSort::sort(keys.ptr(), elements.ptr(), size, tmp_keys, tmp_elements);
+			radix_key_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			for (uint32_t i = 1; i < size && sorted; i++) {
+				sorted = !key_sorter.compare(elements[i], elements[i - 1]);
+			}
+
+			for (uint32_t i = 0; i < size; i++) {
+				elements[i] = &source[from + i];
+			}
+			begin = OS::get_singleton()->get_ticks_usec();
+			SortArray<GLES3BenchmarkElement *, GLES3BenchmarkSortByDepth> depth_sorter;
+			depth_sorter.sort(elements.ptr(), size);
+			sort_array_depth_usec += OS::get_singleton()->get_ticks_usec() - begin;
+
+			for (uint32_t i = 0; i < size; i++) {
+				elements[i] = &source[from + i];
+			}
+			begin = OS::get_singleton()->get_ticks_usec();
+			for (uint32_t i = 0; i < size; i++) {
+				depth_keys[i] = OPENGL3::RadixSort::float_to_key(elements[i]->depth);
+			}
+			OPENGL3::RadixSort::sort(depth_keys.ptr(), elements.ptr(), size, tmp_depth_keys, tmp_elements);
+			radix_depth_usec += OS::get_singleton()->get_ticks_usec() - begin;
+			for (uint32_t i = 1; i < size && sorted; i++) {
+				sorted = elements[i - 1]->depth <= elements[i]->depth;
+			}
+		}
+
+		ERR_FAIL_COND_MSG(!sorted, "RadixSort returned an unsorted list.");
+		String suffix = itos(size / 1000) + "k";
+		_report("sort_key_sort_array_" + suffix, double(sort_array_key_usec) / rounds, "usec/sort");
+		_report("sort_key_radix_" + suffix, double(radix_key_usec) / rounds, "usec/sort");
+		_report("sort_depth_sort_array_" + suffix, double(sort_array_depth_usec) / rounds, "usec/sort");
+		_report("sort_depth_radix_" + suffix, double(radix_depth_usec) / rounds, "usec/sort");
+	}
+}
+
+// Every instance is in view, so they all reach the render list fill after culling.
+void GLES3Benchmark::_setup_scene() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	scenario = rs->scenario_create();
+	rs->viewport_set_scenario(get_root()->get_viewport_rid(), scenario);
+
+	camera = rs->camera_create();
+	rs->camera_set_perspective(camera, 70.0, 0.05, 1000.0);
+	rs->camera_set_transform(camera, Transform3D());
+	rs->viewport_attach_camera(get_root()->get_viewport_rid(), camera);
+
+	light = rs->directional_light_create();
+	light_instance = rs->instance_create2(light, scenario);
+	rs->instance_set_transform(light_instance, Transform3D(Basis::looking_at(Vector3(-1, -1, -1)), Vector3()));
+
+	PackedVector3Array vertices = { Vector3(-0.2, -0.2, 0), Vector3(0.2, -0.2, 0), Vector3(0.2, 0.2, 0), Vector3(-0.2, -0.2, 0), Vector3(0.2, 0.2, 0), Vector3(-0.2, 0.2, 0) };
+	PackedVector3Array normals = { Vector3(0, 0, 1), Vector3(0, 0, 1), Vector3(0, 0, 1), Vector3(0, 0, 1), Vector3(0, 0, 1), Vector3(0, 0, 1) };
+	Array arrays;
+	arrays.resize(RS::ARRAY_MAX);
+	arrays[RS::ARRAY_VERTEX] = vertices;
+	arrays[RS::ARRAY_NORMAL] = normals;
+	mesh = rs->mesh_create();
+	rs->mesh_add_surface_from_arrays(mesh, RS::PRIMITIVE_TRIANGLES, arrays);
+
+	instances.resize(GLES3_BENCHMARK_INSTANCES);
+	for (int y = 0; y < GLES3_BENCHMARK_GRID_HEIGHT; y++) {
+		for (int x = 0; x < GLES3_BENCHMARK_GRID_WIDTH; x++) {
+			RID instance = rs->instance_create2(mesh, scenario);
+			Vector3 origin((x - GLES3_BENCHMARK_GRID_WIDTH / 2) * 0.5, (y - GLES3_BENCHMARK_GRID_HEIGHT / 2) * 0.5, -60.0 - (x + y) % 8);
+			rs->instance_set_transform(instance, Transform3D(Basis(), origin));
+			instances[y * GLES3_BENCHMARK_GRID_WIDTH + x] = instance;
+		}
+	}
+}
+
+void GLES3Benchmark::_start_phase(int p_phase) {
+	phase = p_phase;
+	phase_frame = 0;
+	fill_usec = 0;
+	if (phase < PHASE_MAX) {
+		RendererSceneRenderGLES3::get_singleton()->set_threaded_render_list_fill(phase == PHASE_THREADED_FILL);
+	}
+}
+
+void GLES3Benchmark::initialize() {
+	// The project's own scene would be drawn alongside the benchmark.
+	if (Node *scene = get_current_scene()) {
+		set_current_scene(nullptr);
+		get_root()->remove_child(scene);
+		memdelete(scene);
+	}
+
+	SceneTree::initialize();
+
+	frames = get_requested_frames();
+	if (frames == 0) {
+		frames = GLES3_BENCHMARK_DEFAULT_FRAMES;
+	}
+
+	print_line("GL benchmark, render list sorts:");
+	_run_sort_cases();
+
+	if (OPENGL3::Utilities::get_singleton() == nullptr || RendererSceneRenderGLES3::get_singleton() == nullptr) {
+		ERR_PRINT("The GL benchmark needs the GL Compatibility renderer, run it with --rendering-method gl_compatibility.");
+		quit();
+		return;
+	}
+	threaded_fill_setting = RendererSceneRenderGLES3::get_singleton()->is_threaded_render_list_fill();
+
+	_setup_scene();
+	print_line(vformat("GL benchmark, %d frames per case:", frames));
+	_start_phase(PHASE_SERIAL_FILL);
+}
+
+bool GLES3Benchmark::process(double p_time) {
+	bool should_quit = SceneTree::process(p_time);
+	if (phase >= PHASE_MAX || instances.is_empty()) {
+		return should_quit;
+	}
+
+	// The render info is the one of the last drawn frame, drawn after the previous process() with this phase's setting.
+	if (phase_frame > GLES3_BENCHMARK_WARMUP_FRAMES) {
+		fill_usec += OPENGL3::Utilities::get_singleton()->get_render_info(OPENGL3::Utilities::RENDER_INFO_RENDER_LIST_FILL_USEC);
+	}
+	phase_frame++;
+
+	if (phase_frame > GLES3_BENCHMARK_WARMUP_FRAMES + frames) {
+		_report(phase == PHASE_SERIAL_FILL ? "render_list_fill_serial" : "render_list_fill_threaded", double(fill_usec) / frames, "usec/frame");
+		_start_phase(phase + 1);
+		if (phase == PHASE_MAX) {
+			quit();
+		}
+	}
+	return should_quit;
+}
+
+void GLES3Benchmark::finalize() {
+	RenderingServer *rs = RenderingServer::get_singleton();
+	for (const RID &instance : instances) {
+		rs->free(instance);
+	}
+	instances.clear();
+	if (scenario.is_valid()) {
+		rs->free(light_instance);
+		rs->free(light);
+		rs->free(mesh);
+		rs->free(camera);
+		rs->free(scenario);
+		RendererSceneRenderGLES3::get_singleton()->set_threaded_render_list_fill(threaded_fill_setting);
+	}
+
+	SceneTree::finalize();
+}
+
+#endif // GLES3_ENABLED && TOOLS_ENABLED
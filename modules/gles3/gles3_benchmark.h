@@ -0,0 +1,54 @@
+/**
+ * gles3_benchmark.h
+ *
+ * This file is part of Spike engine, a modification and extension of Godot.
+ *
+ */
+#pragma once
+
+#if defined(GLES3_ENABLED) && defined(TOOLS_ENABLED)
+
+#include "scene/main/scene_tree.h"
+
+#define GLES3_BENCHMARK_ARG "--gl-benchmark"
+
+// Benchmark of the GL Compatibility renderer, started with `--gl-benchmark[=<frames>]`, it needs a window to render to.
+// It replaces the main loop, discards the main scene, compares RadixSort with SortArray on 1k, 10k and 100k element lists, renders a scene of GLES3_BENCHMARK_INSTANCES instances
+// with the serial then the threaded render list fill, prints the fill time per frame of each and quits.
+class GLES3Benchmark : public SceneTree {
+	GDCLASS(GLES3Benchmark, SceneTree);
+
+	enum Phase {
+		PHASE_SERIAL_FILL,
+		PHASE_THREADED_FILL,
+		PHASE_MAX,
+	};
+
+	RID scenario;
+	RID camera;
+	RID mesh;
+	RID light;
+	RID light_instance;
+	LocalVector<RID> instances;
+
+	int frames = 0;
+	int phase = 0;
+	int phase_frame = 0;
+	uint64_t fill_usec = 0;
+	bool threaded_fill_setting = true;
+
+	void _run_sort_cases();
+	void _setup_scene();
+	void _start_phase(int p_phase);
+	void _report(const String &p_name, double p_value, const char *p_unit);
+
+public:
+	// Frames rendered per phase asked on the command line, 0 when no benchmark was requested.
+	static int get_requested_frames();
+
+	virtual void initialize() override;
+	virtual bool process(double p_time) override;
+	virtual void finalize() override;
+};
+
+#endif // GLES3_ENABLED && TOOLS_ENABLED
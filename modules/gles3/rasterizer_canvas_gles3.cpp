@@ -535,6 +535,10 @@ void RendererCanvasRenderGLES3::_render_items(RID p_to_render_target, int p_item
 		return;
 	}
 
+	if (item_reordering_lookahead > 0) {
+		_reorder_items(p_item_count);
+	}
+
 	uint32_t index = 0;
 	Item *current_clip = nullptr;
 
@@ -731,6 +735,8 @@ void RendererCanvasRenderGLES3::_render_items(RID p_to_render_target, int p_item
 		_render_batch(p_lights, i);
 	}
 
+	OPENGL3::Utilities::get_singleton()->render_info_add(OPENGL3::Utilities::RENDER_INFO_CANVAS_BATCHES, state.current_batch_index + 1);
+
 	state.current_batch_index = 0;
 	state.canvas_instance_batches.clear();
 	r_last_index += index;
@@ -1405,6 +1411,122 @@ void RendererCanvasRenderGLES3::_render_batch(Light *p_lights, uint32_t p_index)
 	}
 }
 
+void RendererCanvasRenderGLES3::_get_item_batch_key(const Item *p_item, ItemBatchKey &r_key) const {
+	r_key = ItemBatchKey();
+
+	if (p_item->canvas_group != nullptr) {
+		r_key.barrier = true;
+		return;
+	}
+
+	// Same resolution as _render_items and _record_item_commands.
+	r_key.material = p_item->material_owner == nullptr ? p_item->material : p_item->material_owner->material;
+	r_key.clip = p_item->final_clip_owner;
+	r_key.filter = p_item->texture_filter == RS::CANVAS_ITEM_TEXTURE_FILTER_DEFAULT ? state.default_filter : p_item->texture_filter;
+	r_key.repeat = p_item->texture_repeat == RS::CANVAS_ITEM_TEXTURE_REPEAT_DEFAULT ? state.default_repeat : p_item->texture_repeat;
+
+	bool uniform = true;
+	const Item::Command *c = p_item->commands;
+	while (c) {
+		RID texture;
+		Item::Command::Type type = Item::Command::TYPE_ANIMATION_SLICE;
+		if (c->type == Item::Command::TYPE_RECT) {
+			const Item::CommandRect *rect = static_cast<const Item::CommandRect *>(c);
+			// LCD and tiled rects change the blend mode or repeat of the batch.
+			if (!(rect->flags & (CANVAS_RECT_LCD | CANVAS_RECT_TILE))) {
+				texture = rect->texture;
+				type = c->type;
+			}
+		} else if (c->type == Item::Command::TYPE_NINEPATCH) {
+			texture = static_cast<const Item::CommandNinePatch *>(c)->texture;
+			type = c->type;
+		}
+
+		if (c == p_item->commands) {
+			r_key.texture = texture;
+			r_key.command_type = type;
+		} else if (texture != r_key.texture || type != r_key.command_type) {
+			uniform = false;
+		}
+		r_key.last_texture = texture;
+		r_key.last_command_type = type;
+		c = c->next;
+	}
+
+	// Items of unknown bounds stay in place, they count as overlapping everything.
+	r_key.movable = uniform && r_key.command_type != Item::Command::TYPE_ANIMATION_SLICE && p_item->global_rect_cache.has_area();
+}
+
+void RendererCanvasRenderGLES3::_reorder_items(int p_item_count) {
+	if (item_batch_keys.size() < (uint32_t)p_item_count) {
+		item_batch_keys.resize(p_item_count);
+	}
+	ItemBatchKey *keys = item_batch_keys.ptr();
+	for (int i = 0; i < p_item_count; i++) {
+		_get_item_batch_key(items[i], keys[i]);
+	}
+
+	// Batches as recorded, an item whose first command can join the batch of the previous one does not start a new one.
+	uint32_t batches_before = 1;
+	for (int i = 1; i < p_item_count; i++) {
+		if (!keys[i].continues_batch(keys[i - 1])) {
+			batches_before++;
+		}
+	}
+
+	for (int i = 0; i < p_item_count - 1; i++) {
+		if (!keys[i].movable || keys[i + 1].batches_with(keys[i])) {
+			continue;
+		}
+
+		int limit = MIN(p_item_count, i + 1 + (int)item_reordering_lookahead);
+		for (int j = i + 2; j < limit; j++) {
+			if (keys[j].barrier) {
+				break;
+			}
+			if (!keys[j].batches_with(keys[i])) {
+				continue;
+			}
+
+			// The candidate is drawn before every item it jumps over, which is only correct if none of them is a
+			// canvas group and none overlaps it.
+			const Rect2 &rect = items[j]->global_rect_cache;
+			int k = i + 1;
+			while (k < j && !keys[k].barrier && items[k]->global_rect_cache.has_area() && !items[k]->global_rect_cache.intersects(rect)) {
+				k++;
+			}
+			if (k < j) {
+				if (keys[k].barrier) {
+					break;
+				}
+				continue;
+			}
+
+			Item *item = items[j];
+			ItemBatchKey key = keys[j];
+			for (int k = j; k > i + 1; k--) {
+				items[k] = items[k - 1];
+				keys[k] = keys[k - 1];
+			}
+			items[i + 1] = item;
+			keys[i + 1] = key;
+			break;
+		}
+	}
+
+	uint32_t batches_after = 1;
+	for (int i = 1; i < p_item_count; i++) {
+		if (!keys[i].continues_batch(keys[i - 1])) {
+			batches_after++;
+		}
+	}
+
+	// A move may split a run of items that batched together, only the batches actually saved are counted.
+	if (batches_before > batches_after) {
+		OPENGL3::Utilities::get_singleton()->render_info_add(OPENGL3::Utilities::RENDER_INFO_CANVAS_BATCHES_MERGED, batches_before - batches_after);
+	}
+}
+
 void RendererCanvasRenderGLES3::_add_to_batch(uint32_t &r_index, bool &r_batch_broken) {
 	if (r_index >= data.max_instances_per_buffer - 1) {
 		ERR_PRINT_ONCE("Trying to draw too many items. Please increase maximum number of items in the project settings 'rendering/gl_compatibility/item_buffer_size'");
@@ -2561,6 +2683,7 @@ RendererCanvasRenderGLES3::RendererCanvasRenderGLES3() {
 
 	// Reserve 3 Uniform Buffers for instance data Frame N, N+1 and N+2
 	data.max_instances_per_buffer = MAX(data.max_instances_per_batch, uint32_t(GLOBAL_GET("rendering/gl_compatibility/item_buffer_size")));
+	item_reordering_lookahead = GLOBAL_GET("rendering/gl_compatibility/batching/item_reordering_lookahead");
 	data.max_instance_buffer_size = data.max_instances_per_buffer * sizeof(InstanceData); // 16,384 instances * 128 bytes = 2,097,152 bytes = 2,048 kb
 	state.canvas_instance_data_buffers.resize(3);
 	state.canvas_instance_batches.reserve(200);
@@ -292,6 +292,36 @@ public:
 
 	Item *items[MAX_RENDER_ITEMS];
 
+	// Item reordering, lets an item draw earlier than items it does not overlap so that it joins
+	// the batch of a previous item with the same texture, material and state.
+	struct ItemBatchKey {
+		RID material;
+		RID texture; // Texture and type of the first command, TYPE_ANIMATION_SLICE when it always breaks the batch.
+		RID last_texture;
+		Item *clip = nullptr;
+		Item::Command::Type command_type = Item::Command::TYPE_ANIMATION_SLICE;
+		Item::Command::Type last_command_type = Item::Command::TYPE_ANIMATION_SLICE;
+		RS::CanvasItemTextureFilter filter = RS::CANVAS_ITEM_TEXTURE_FILTER_MAX;
+		RS::CanvasItemTextureRepeat repeat = RS::CANVAS_ITEM_TEXTURE_REPEAT_MAX;
+		bool movable = false; // Only items made of rects or nine patches with a single texture are moved.
+		bool barrier = false; // Nothing is moved across canvas groups.
+
+		_FORCE_INLINE_ bool batches_with(const ItemBatchKey &p_other) const {
+			return movable && p_other.movable && material == p_other.material && texture == p_other.texture && clip == p_other.clip && command_type == p_other.command_type && filter == p_other.filter && repeat == p_other.repeat;
+		}
+
+		// Whether this item, drawn right after `p_prev`, adds its first command to the batch `p_prev` ends with.
+		_FORCE_INLINE_ bool continues_batch(const ItemBatchKey &p_prev) const {
+			return !barrier && !p_prev.barrier && command_type != Item::Command::TYPE_ANIMATION_SLICE && material == p_prev.material && clip == p_prev.clip && filter == p_prev.filter && repeat == p_prev.repeat && texture == p_prev.last_texture && command_type == p_prev.last_command_type;
+		}
+	};
+
+	uint32_t item_reordering_lookahead = 16;
+	LocalVector<ItemBatchKey> item_batch_keys;
+
+	void _get_item_batch_key(const Item *p_item, ItemBatchKey &r_key) const;
+	void _reorder_items(int p_item_count);
+
 	RID default_canvas_texture;
 	RID default_canvas_group_material;
 	RID default_canvas_group_shader;
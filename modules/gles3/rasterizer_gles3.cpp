@@ -254,6 +254,8 @@ void RendererCompositorGLES3::prepare_for_blitting_render_targets() {
 	// This allows us to only increment the frame after all viewports are done.
 	OPENGL3::Utilities *utils = OPENGL3::Utilities::get_singleton();
 	utils->capture_timestamps_end();
+	utils->render_info_end_frame();
+	mesh_storage->software_skinning_end_frame();
 }
 
 void RendererCompositorGLES3::_blit_render_target_to_screen(RID p_render_target, DisplayServer::WindowID p_screen, const Rect2 &p_screen_rect, uint32_t p_layer) {
@@ -6,6 +6,8 @@
  */
 #include "rasterizer_scene_gles3.h"
 #include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
 #include "core/templates/sort_array.h"
 #include "servers/rendering/rendering_server_default.h"
 #include "servers/rendering/rendering_server_globals.h"
@@ -1087,8 +1089,6 @@ void RendererSceneRenderGLES3::voxel_gi_set_quality(RS::VoxelGIQuality) {
 }
 
 void RendererSceneRenderGLES3::_fill_render_list(RenderListType p_render_list, const RenderDataGLES3 *p_render_data, PassMode p_pass_mode, bool p_append) {
-	OPENGL3::MeshStorage *mesh_storage = OPENGL3::MeshStorage::get_singleton();
-
 	if (p_render_list == RENDER_LIST_OPAQUE) {
 		scene_state.used_screen_texture = false;
 		scene_state.used_normal_texture = false;
@@ -1116,17 +1116,81 @@ void RendererSceneRenderGLES3::_fill_render_list(RenderListType p_render_list, c
 
 	//fill list
 
-	for (int i = 0; i < (int)p_render_data->instances->size(); i++) {
-		GeometryInstanceGLES3 *inst = static_cast<GeometryInstanceGLES3 *>((*p_render_data->instances)[i]);
+	uint64_t fill_begin = OS::get_singleton()->get_ticks_usec();
+
+	FillRenderListParams &params = fill_render_list_params;
+	params.render_data = p_render_data;
+	params.pass_mode = p_pass_mode;
+	params.near_plane = near_plane;
+	params.z_max = z_max;
+#ifdef DEBUG_ENABLED
+	params.force_alpha = unlikely(get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_OVERDRAW);
+#else
+	params.force_alpha = false;
+#endif
+
+	uint32_t instance_count = p_render_data->instances->size();
+	uint32_t chunk_count = 1;
+	params.chunk_size = MAX(instance_count, 1u);
+	if (use_threaded_render_list_fill && instance_count >= FILL_RENDER_LIST_CHUNK_SIZE * 2) {
+		params.chunk_size = FILL_RENDER_LIST_CHUNK_SIZE;
+		chunk_count = (instance_count + FILL_RENDER_LIST_CHUNK_SIZE - 1) / FILL_RENDER_LIST_CHUNK_SIZE;
+	}
+	if (fill_render_list_chunks.size() < chunk_count) {
+		// Never shrunk, so the chunk lists keep their capacity between frames.
+		fill_render_list_chunks.resize(chunk_count);
+	}
+
+	if (chunk_count > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &RendererSceneRenderGLES3::_fill_render_list_chunk, fill_render_list_chunks.ptr(), chunk_count, -1, true, "FillRenderList");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		_fill_render_list_chunk(0, fill_render_list_chunks.ptr());
+	}
+
+	// Merge in chunk order, so the lists are identical to a serial fill.
+	RenderList *alpha_rl = &render_list[RENDER_LIST_ALPHA];
+	for (uint32_t i = 0; i < chunk_count; i++) {
+		const FillRenderListChunk &chunk = fill_render_list_chunks[i];
+		for (GeometryInstanceSurface *surf : chunk.elements) {
+			rl->add_element(surf);
+		}
+		for (GeometryInstanceSurface *surf : chunk.alpha_elements) {
+			alpha_rl->add_element(surf);
+		}
+		scene_state.used_screen_texture = scene_state.used_screen_texture || chunk.used_screen_texture;
+		scene_state.used_normal_texture = scene_state.used_normal_texture || chunk.used_normal_texture;
+		scene_state.used_depth_texture = scene_state.used_depth_texture || chunk.used_depth_texture;
+	}
+
+	OPENGL3::Utilities::get_singleton()->render_info_add(OPENGL3::Utilities::RENDER_INFO_RENDER_LIST_FILL_USEC, OS::get_singleton()->get_ticks_usec() - fill_begin);
+}
+
+void RendererSceneRenderGLES3::_fill_render_list_chunk(uint32_t p_chunk, FillRenderListChunk *p_chunks) {
+	OPENGL3::MeshStorage *mesh_storage = OPENGL3::MeshStorage::get_singleton();
+	const FillRenderListParams &params = fill_render_list_params;
+	FillRenderListChunk &chunk = p_chunks[p_chunk];
+
+	chunk.elements.clear();
+	chunk.alpha_elements.clear();
+	chunk.used_screen_texture = false;
+	chunk.used_normal_texture = false;
+	chunk.used_depth_texture = false;
+
+	uint32_t from = p_chunk * params.chunk_size;
+	uint32_t to = MIN(from + params.chunk_size, (uint32_t)params.render_data->instances->size());
+
+	for (uint32_t i = from; i < to; i++) {
+		GeometryInstanceGLES3 *inst = static_cast<GeometryInstanceGLES3 *>((*params.render_data->instances)[i]);
 
-		if (p_render_data->cam_orthogonal) {
-			Vector3 support_min = inst->transformed_aabb.get_support(-near_plane.normal);
-			inst->depth = near_plane.distance_to(support_min);
+		if (params.render_data->cam_orthogonal) {
+			Vector3 support_min = inst->transformed_aabb.get_support(-params.near_plane.normal);
+			inst->depth = params.near_plane.distance_to(support_min);
 		} else {
 			Vector3 aabb_center = inst->transformed_aabb.position + (inst->transformed_aabb.size * 0.5);
-			inst->depth = p_render_data->cam_transform.origin.distance_to(aabb_center);
+			inst->depth = params.render_data->cam_transform.origin.distance_to(aabb_center);
 		}
-		uint32_t depth_layer = CLAMP(int(inst->depth * 16 / z_max), 0, 15);
+		uint32_t depth_layer = CLAMP(int(inst->depth * 16 / params.z_max), 0, 15);
 
 		uint32_t flags = inst->base_flags; //fill flags if appropriate
 
@@ -1137,7 +1201,7 @@ void RendererSceneRenderGLES3::_fill_render_list(RenderListType p_render_list, c
 		// Sets the index values for lookup in the shader
 		// This has to be done after _setup_lights was called this frame
 		// TODO, check shadow status of lights here, if using shadows, skip here and add below
-		if (p_pass_mode == PASS_MODE_COLOR) {
+		if (params.pass_mode == PASS_MODE_COLOR) {
 			if (inst->omni_light_count) {
 				inst->omni_light_gl_cache.resize(inst->omni_light_count);
 				for (uint32_t j = 0; j < inst->omni_light_count; j++) {
@@ -1159,14 +1223,14 @@ void RendererSceneRenderGLES3::_fill_render_list(RenderListType p_render_list, c
 		while (surf) {
 			// LOD
 
-			if (p_render_data->screen_mesh_lod_threshold > 0.0 && mesh_storage->mesh_surface_has_lod(surf->surface)) {
+			if (params.render_data->screen_mesh_lod_threshold > 0.0 && mesh_storage->mesh_surface_has_lod(surf->surface)) {
 				// Get the LOD support points on the mesh AABB.
-				Vector3 lod_support_min = inst->transformed_aabb.get_support(p_render_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
-				Vector3 lod_support_max = inst->transformed_aabb.get_support(-p_render_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
+				Vector3 lod_support_min = inst->transformed_aabb.get_support(params.render_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
+				Vector3 lod_support_max = inst->transformed_aabb.get_support(-params.render_data->cam_transform.basis.get_column(Vector3::AXIS_Z));
 
 				// Get the distances to those points on the AABB from the camera origin.
-				float distance_min = (float)p_render_data->cam_transform.origin.distance_to(lod_support_min);
-				float distance_max = (float)p_render_data->cam_transform.origin.distance_to(lod_support_max);
+				float distance_min = (float)params.render_data->cam_transform.origin.distance_to(lod_support_min);
+				float distance_max = (float)params.render_data->cam_transform.origin.distance_to(lod_support_max);
 
 				float distance = 0.0;
 
@@ -1179,73 +1243,68 @@ void RendererSceneRenderGLES3::_fill_render_list(RenderListType p_render_list, c
 					distance = -distance_max;
 				}
 
-				if (p_render_data->cam_orthogonal) {
+				if (params.render_data->cam_orthogonal) {
 					distance = 1.0;
 				}
 
 				uint32_t indices = 0;
-				surf->lod_index = mesh_storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * p_render_data->lod_distance_multiplier, p_render_data->screen_mesh_lod_threshold, indices);
+				surf->lod_index = mesh_storage->mesh_surface_get_lod(surf->surface, inst->lod_model_scale * inst->lod_bias, distance * params.render_data->lod_distance_multiplier, params.render_data->screen_mesh_lod_threshold, indices);
 				/*
-				if (p_render_data->render_info) {
+				if (params.render_data->render_info) {
 					indices = _indices_to_primitives(surf->primitive, indices);
 					if (p_render_list == RENDER_LIST_OPAQUE) { //opaque
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += indices;
+						params.render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += indices;
 					} else if (p_render_list == RENDER_LIST_SECONDARY) { //shadow
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += indices;
+						params.render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += indices;
 					}
 				}
 				*/
 			} else {
 				surf->lod_index = 0;
 				/*
-				if (p_render_data->render_info) {
+				if (params.render_data->render_info) {
 					uint32_t to_draw = mesh_storage->mesh_surface_get_vertices_drawn_count(surf->surface);
 					to_draw = _indices_to_primitives(surf->primitive, to_draw);
 					to_draw *= inst->instance_count;
 					if (p_render_list == RENDER_LIST_OPAQUE) { //opaque
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += mesh_storage->mesh_surface_get_vertices_drawn_count(surf->surface);
+						params.render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_VISIBLE][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += mesh_storage->mesh_surface_get_vertices_drawn_count(surf->surface);
 					} else if (p_render_list == RENDER_LIST_SECONDARY) { //shadow
-						p_render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += mesh_storage->mesh_surface_get_vertices_drawn_count(surf->surface);
+						params.render_data->render_info->info[RS::VIEWPORT_RENDER_INFO_TYPE_SHADOW][RS::VIEWPORT_RENDER_INFO_PRIMITIVES_IN_FRAME] += mesh_storage->mesh_surface_get_vertices_drawn_count(surf->surface);
 					}
 				}
 				*/
 			}
 
 			// ADD Element
-			if (p_pass_mode == PASS_MODE_COLOR) {
-#ifdef DEBUG_ENABLED
-				bool force_alpha = unlikely(get_debug_draw_mode() == RS::VIEWPORT_DEBUG_DRAW_OVERDRAW);
-#else
-				bool force_alpha = false;
-#endif
-				if (!force_alpha && (surf->flags & GeometryInstanceSurface::FLAG_PASS_OPAQUE)) {
-					rl->add_element(surf);
+			if (params.pass_mode == PASS_MODE_COLOR) {
+				if (!params.force_alpha && (surf->flags & GeometryInstanceSurface::FLAG_PASS_OPAQUE)) {
+					chunk.elements.push_back(surf);
 				}
-				if (force_alpha || (surf->flags & GeometryInstanceSurface::FLAG_PASS_ALPHA)) {
-					render_list[RENDER_LIST_ALPHA].add_element(surf);
+				if (params.force_alpha || (surf->flags & GeometryInstanceSurface::FLAG_PASS_ALPHA)) {
+					chunk.alpha_elements.push_back(surf);
 				}
 
 				if (surf->flags & GeometryInstanceSurface::FLAG_USES_SCREEN_TEXTURE) {
-					scene_state.used_screen_texture = true;
+					chunk.used_screen_texture = true;
 				}
 				if (surf->flags & GeometryInstanceSurface::FLAG_USES_NORMAL_TEXTURE) {
-					scene_state.used_normal_texture = true;
+					chunk.used_normal_texture = true;
 				}
 				if (surf->flags & GeometryInstanceSurface::FLAG_USES_DEPTH_TEXTURE) {
-					scene_state.used_depth_texture = true;
+					chunk.used_depth_texture = true;
 				}
 
 				/*
 					Add elements here if there are shadows
 				*/
 
-			} else if (p_pass_mode == PASS_MODE_SHADOW) {
+			} else if (params.pass_mode == PASS_MODE_SHADOW) {
 				if (surf->flags & GeometryInstanceSurface::FLAG_PASS_SHADOW) {
-					rl->add_element(surf);
+					chunk.elements.push_back(surf);
 				}
 			} else {
 				if (surf->flags & (GeometryInstanceSurface::FLAG_PASS_DEPTH | GeometryInstanceSurface::FLAG_PASS_OPAQUE)) {
-					rl->add_element(surf);
+					chunk.elements.push_back(surf);
 				}
 			}
 
@@ -1995,6 +2054,7 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 	}
 
 	bool should_request_redraw = false;
+	bool used_auto_instancing = false;
 
 	for (uint32_t i = p_from_element; i < p_to_element; i++) {
 		const GeometryInstanceSurface *surf = p_params->elements[i];
@@ -2026,6 +2086,13 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 			continue;
 		}
 
+		// Number of elements drawn by this iteration, more than one when auto instancing.
+		uint32_t auto_instance_count = 1;
+		if (auto_instancing.enabled && inst->instance_count < 0) {
+			auto_instance_count = _auto_instancing_get_run<p_pass_mode>(p_params, i, p_to_element);
+		}
+		bool use_instancing = inst->instance_count > 0 || auto_instance_count > 1;
+
 		//request a redraw if one of the shaders uses TIME
 		if (shader->uses_time) {
 			should_request_redraw = true;
@@ -2170,8 +2237,8 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 		}
 
 		Transform3D world_transform;
-		if (inst->store_transform_cache) {
-			world_transform = inst->transform;
+		if (inst->store_transform_cache && auto_instance_count == 1) {
+			world_transform = inst->transform; // Auto instanced elements have it in the instance buffer.
 		}
 
 		if (prev_material_data != material_data) {
@@ -2180,8 +2247,8 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 		}
 
 		SceneShaderGLES3::ShaderVariant instance_variant = shader_variant;
-		if (inst->instance_count > 0) {
-			// Will need to use instancing to draw (either MultiMesh or Particles).
+		if (use_instancing) {
+			// Will need to use instancing to draw (either MultiMesh, Particles or auto instancing).
 			instance_variant = SceneShaderGLES3::ShaderVariant(1 + int(shader_variant));
 		}
 
@@ -2232,13 +2299,21 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 		}
 
 		material_storage->shaders.scene_shader.version_set_uniform(SceneShaderGLES3::WORLD_TRANSFORM, world_transform, shader->version, instance_variant, spec_constants);
-		if (inst->instance_count > 0) {
-			// Using MultiMesh or Particles.
+		if (use_instancing) {
+			// Using MultiMesh, Particles or auto instancing.
 			// Bind instance buffers.
 
 			GLuint instance_buffer = 0;
 			uint32_t stride = 0;
-			if (inst->flags_cache & INSTANCE_DATA_FLAG_PARTICLES) {
+			uint32_t instance_offset = 0;
+			uint32_t instance_flags = inst->flags_cache;
+			uint32_t instances_to_draw = inst->instance_count;
+			if (auto_instance_count > 1) {
+				instance_buffer = _auto_instancing_upload(p_params, i, auto_instance_count, instance_offset);
+				stride = AUTO_INSTANCING_STRIDE;
+				instance_flags = INSTANCE_DATA_FLAG_MULTIMESH | INSTANCE_DATA_FLAG_MULTIMESH_HAS_COLOR | INSTANCE_DATA_FLAG_MULTIMESH_HAS_CUSTOM_DATA;
+				instances_to_draw = auto_instance_count;
+			} else if (inst->flags_cache & INSTANCE_DATA_FLAG_PARTICLES) {
 				instance_buffer = particles_storage->particles_get_gl_buffer(inst->data->base);
 				stride = 16; // 12 bytes for instance transform and 4 bytes for packed color and custom.
 			} else {
@@ -2254,27 +2329,34 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 			glBindBuffer(GL_ARRAY_BUFFER, instance_buffer);
 
 			glEnableVertexAttribArray(12);
-			glVertexAttribPointer(12, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(0));
+			glVertexAttribPointer(12, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset));
 			glVertexAttribDivisor(12, 1);
 			glEnableVertexAttribArray(13);
-			glVertexAttribPointer(13, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(sizeof(float) * 4));
+			glVertexAttribPointer(13, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset + sizeof(float) * 4));
 			glVertexAttribDivisor(13, 1);
-			if (!(inst->flags_cache & INSTANCE_DATA_FLAG_MULTIMESH_FORMAT_2D)) {
+			if (!(instance_flags & INSTANCE_DATA_FLAG_MULTIMESH_FORMAT_2D)) {
 				glEnableVertexAttribArray(14);
-				glVertexAttribPointer(14, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(sizeof(float) * 8));
+				glVertexAttribPointer(14, 4, GL_FLOAT, GL_FALSE, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset + sizeof(float) * 8));
 				glVertexAttribDivisor(14, 1);
 			}
 
-			if ((inst->flags_cache & INSTANCE_DATA_FLAG_MULTIMESH_HAS_COLOR) || (inst->flags_cache & INSTANCE_DATA_FLAG_MULTIMESH_HAS_CUSTOM_DATA)) {
-				uint32_t color_custom_offset = inst->flags_cache & INSTANCE_DATA_FLAG_MULTIMESH_FORMAT_2D ? 8 : 12;
+			if ((instance_flags & INSTANCE_DATA_FLAG_MULTIMESH_HAS_COLOR) || (instance_flags & INSTANCE_DATA_FLAG_MULTIMESH_HAS_CUSTOM_DATA)) {
+				uint32_t color_custom_offset = instance_flags & INSTANCE_DATA_FLAG_MULTIMESH_FORMAT_2D ? 8 : 12;
 				glEnableVertexAttribArray(15);
-				glVertexAttribIPointer(15, 4, GL_UNSIGNED_INT, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(color_custom_offset * sizeof(float)));
+				glVertexAttribIPointer(15, 4, GL_UNSIGNED_INT, stride * sizeof(float), CAST_INT_TO_UCHAR_PTR(instance_offset + color_custom_offset * sizeof(float)));
 				glVertexAttribDivisor(15, 1);
 			}
 			if (use_index_buffer) {
-				glDrawElementsInstanced(primitive_gl, mesh_storage->mesh_surface_get_vertices_drawn_count(mesh_surface), mesh_storage->mesh_surface_get_index_type(mesh_surface), 0, inst->instance_count);
+				glDrawElementsInstanced(primitive_gl, mesh_storage->mesh_surface_get_vertices_drawn_count(mesh_surface), mesh_storage->mesh_surface_get_index_type(mesh_surface), 0, instances_to_draw);
 			} else {
-				glDrawArraysInstanced(primitive_gl, 0, mesh_storage->mesh_surface_get_vertices_drawn_count(mesh_surface), inst->instance_count);
+				glDrawArraysInstanced(primitive_gl, 0, mesh_storage->mesh_surface_get_vertices_drawn_count(mesh_surface), instances_to_draw);
+			}
+			if (auto_instance_count > 1) {
+				OPENGL3::Utilities *utilities = OPENGL3::Utilities::get_singleton();
+				utilities->render_info_add(OPENGL3::Utilities::RENDER_INFO_AUTO_INSTANCING_DRAWS, 1);
+				utilities->render_info_add(OPENGL3::Utilities::RENDER_INFO_AUTO_INSTANCING_ELEMENTS, auto_instance_count);
+				used_auto_instancing = true;
+				i += auto_instance_count - 1;
 			}
 		} else {
 			// Using regular Mesh.
@@ -2284,7 +2366,7 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 				glDrawArrays(primitive_gl, 0, mesh_storage->mesh_surface_get_vertices_drawn_count(mesh_surface));
 			}
 		}
-		if (inst->instance_count > 0) {
+		if (use_instancing) {
 			glDisableVertexAttribArray(12);
 			glDisableVertexAttribArray(13);
 			glDisableVertexAttribArray(14);
@@ -2292,12 +2374,157 @@ void RendererSceneRenderGLES3::_render_list_template(RenderListParameters *p_par
 		}
 	}
 
+	if (used_auto_instancing) {
+		// Guards the current instance buffer until the GPU is done with this pass.
+		GLsync &fence = auto_instancing.fences[auto_instancing.current_buffer];
+		if (fence != GLsync()) {
+			glDeleteSync(fence);
+		}
+		fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+
 	// Make the actual redraw request
 	if (should_request_redraw) {
 		RenderingServerDefault::redraw_request();
 	}
 }
 
+template <PassMode p_pass_mode>
+uint32_t RendererSceneRenderGLES3::_auto_instancing_get_run(const RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_to_element) const {
+	const GeometryInstanceSurface *first = p_params->elements[p_from_element];
+	const GeometryInstanceGLES3 *first_inst = first->owner;
+	if (first_inst->mesh_instance.is_valid()) {
+		return 1; // Skinned and blend shape surfaces each have their own vertex buffer.
+	}
+
+	uint32_t to = p_from_element + 1;
+	uint32_t max_to = MIN(p_to_element, p_from_element + AUTO_INSTANCING_MAX_INSTANCES);
+	for (; to < max_to; to++) {
+		const GeometryInstanceSurface *surf = p_params->elements[to];
+		const GeometryInstanceGLES3 *inst = surf->owner;
+
+		if (p_pass_mode == PASS_MODE_COLOR && !(surf->flags & GeometryInstanceSurface::FLAG_PASS_OPAQUE)) {
+			break;
+		}
+		if (inst->instance_count >= 0 || inst->mesh_instance.is_valid()) {
+			break;
+		}
+
+		if constexpr (p_pass_mode == PASS_MODE_SHADOW) {
+			if (surf->surface_shadow != first->surface_shadow || surf->material_shadow != first->material_shadow || surf->shader_shadow != first->shader_shadow) {
+				break;
+			}
+		} else {
+			if (surf->surface != first->surface || surf->material != first->material || surf->shader != first->shader) {
+				break;
+			}
+		}
+		if (surf->lod_index != first->lod_index) {
+			break;
+		}
+
+		// Same cull variant.
+		if ((surf->flags & GeometryInstanceSurface::FLAG_USES_DOUBLE_SIDED_SHADOWS) != (first->flags & GeometryInstanceSurface::FLAG_USES_DOUBLE_SIDED_SHADOWS) || inst->mirror != first_inst->mirror) {
+			break;
+		}
+
+		// Same light uniforms and specialization.
+		if (inst->omni_light_count != first_inst->omni_light_count || inst->spot_light_count != first_inst->spot_light_count) {
+			break;
+		}
+		if (inst->omni_light_count && memcmp(inst->omni_light_gl_cache.ptr(), first_inst->omni_light_gl_cache.ptr(), inst->omni_light_count * sizeof(uint32_t)) != 0) {
+			break;
+		}
+		if (inst->spot_light_count && memcmp(inst->spot_light_gl_cache.ptr(), first_inst->spot_light_gl_cache.ptr(), inst->spot_light_count * sizeof(uint32_t)) != 0) {
+			break;
+		}
+	}
+
+	return to - p_from_element;
+}
+
+GLuint RendererSceneRenderGLES3::_auto_instancing_upload(const RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_count, uint32_t &r_offset) {
+	AutoInstancing &ai = auto_instancing;
+
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+	if (ai.frame != frame) {
+		ai.frame = frame;
+		ai.current_buffer = (ai.current_buffer + 1) % AUTO_INSTANCING_BUFFER_COUNT;
+		ai.offset = 0;
+
+		GLsync &fence = ai.fences[ai.current_buffer];
+		if (fence != GLsync()) {
+#ifndef WEB_ENABLED
+			// Last used AUTO_INSTANCING_BUFFER_COUNT frames ago, this should be signaled already.
+			glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000); // wait for up to 100ms
+#endif
+			glDeleteSync(fence);
+			fence = GLsync();
+		}
+	}
+
+	GLuint &buffer = ai.buffers[ai.current_buffer];
+	uint32_t &buffer_size = ai.buffer_sizes[ai.current_buffer];
+	uint32_t size = p_count * AUTO_INSTANCING_STRIDE * sizeof(float);
+
+	if (buffer == 0) {
+		glGenBuffers(1, &buffer);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, buffer);
+
+	if (ai.offset + size > buffer_size) {
+		// Grow, draws already issued this frame keep the orphaned storage.
+		buffer_size = next_power_of_2(MAX(ai.offset + size, AUTO_INSTANCING_MAX_INSTANCES * AUTO_INSTANCING_STRIDE * (uint32_t)sizeof(float)));
+		glBufferData(GL_ARRAY_BUFFER, buffer_size, nullptr, GL_STREAM_DRAW);
+		ai.offset = 0;
+	}
+
+#ifdef WEB_ENABLED
+	ai.data.resize(p_count * AUTO_INSTANCING_STRIDE);
+	float *data = ai.data.ptr();
+#else
+	// On Desktop and mobile we map the memory without synchronizing, this range is not used by any draw in flight.
+	float *data = static_cast<float *>(glMapBufferRange(GL_ARRAY_BUFFER, ai.offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT));
+	ERR_FAIL_NULL_V(data, 0);
+#endif
+
+	// White color and zero custom data, packed as half floats.
+	static const uint32_t color_custom[4] = { 0x3C003C00, 0x3C003C00, 0, 0 };
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const GeometryInstanceGLES3 *inst = p_params->elements[p_from_element + i]->owner;
+		Transform3D transform;
+		if (inst->store_transform_cache) {
+			transform = inst->transform;
+		}
+
+		float *dataptr = data + i * AUTO_INSTANCING_STRIDE;
+		dataptr[0] = transform.basis.rows[0][0];
+		dataptr[1] = transform.basis.rows[0][1];
+		dataptr[2] = transform.basis.rows[0][2];
+		dataptr[3] = transform.origin.x;
+		dataptr[4] = transform.basis.rows[1][0];
+		dataptr[5] = transform.basis.rows[1][1];
+		dataptr[6] = transform.basis.rows[1][2];
+		dataptr[7] = transform.origin.y;
+		dataptr[8] = transform.basis.rows[2][0];
+		dataptr[9] = transform.basis.rows[2][1];
+		dataptr[10] = transform.basis.rows[2][2];
+		dataptr[11] = transform.origin.z;
+		memcpy(dataptr + 12, color_custom, sizeof(color_custom));
+	}
+
+#ifdef WEB_ENABLED
+	glBufferSubData(GL_ARRAY_BUFFER, ai.offset, size, data);
+#else
+	glUnmapBuffer(GL_ARRAY_BUFFER);
+#endif
+
+	r_offset = ai.offset;
+	ai.offset += size;
+	return buffer;
+}
+
 void RendererSceneRenderGLES3::render_material(const Transform3D &p_cam_transform, const Projection &p_cam_projection, bool p_cam_orthogonal, const PagedArray<RenderGeometryInstance *> &p_instances, RID p_framebuffer, const Rect2i &p_region) {
 }
 
@@ -2473,6 +2700,8 @@ RendererSceneRenderGLES3::RendererSceneRenderGLES3() {
 
 	// Quality settings.
 	use_physical_light_units = GLOBAL_GET("rendering/lights_and_shadows/use_physical_light_units");
+	use_threaded_render_list_fill = GLOBAL_GET("rendering/gl_compatibility/threaded_render_list_fill");
+	auto_instancing.enabled = GLOBAL_GET("rendering/gl_compatibility/auto_instancing");
 
 	{
 		// Setup Lights
@@ -2644,6 +2873,14 @@ RendererSceneRenderGLES3::~RendererSceneRenderGLES3() {
 	glDeleteBuffers(1, &scene_state.directional_light_buffer);
 	glDeleteBuffers(1, &scene_state.omni_light_buffer);
 	glDeleteBuffers(1, &scene_state.spot_light_buffer);
+	for (uint32_t i = 0; i < AUTO_INSTANCING_BUFFER_COUNT; i++) {
+		if (auto_instancing.buffers[i] != 0) {
+			glDeleteBuffers(1, &auto_instancing.buffers[i]);
+		}
+		if (auto_instancing.fences[i] != GLsync()) {
+			glDeleteSync(auto_instancing.fences[i]);
+		}
+	}
 	memdelete_arr(scene_state.directional_lights);
 	memdelete_arr(scene_state.omni_lights);
 	memdelete_arr(scene_state.spot_lights);
@@ -22,6 +22,7 @@
 #include "drivers/gles3/storage/light_storage.h"
 #include "drivers/gles3/storage/material_storage.h"
 #include "drivers/gles3/storage/render_scene_buffers_gles3.h"
+#include "storage/radix_sort.h"
 #include "storage/utilities.h"
 
 enum RenderListType {
@@ -382,12 +383,15 @@ private:
 	struct RenderList {
 		LocalVector<GeometryInstanceSurface *> elements;
 
+		// Radix sort scratch, kept between frames.
+		LocalVector<uint64_t> sort_keys;
+		LocalVector<uint64_t> sort_tmp_keys;
+		LocalVector<GeometryInstanceSurface *> sort_tmp_elements;
+
 		void clear() {
 			elements.clear();
 		}
 
-		//should eventually be replaced by radix
-
 		struct SortByKey {
 			_FORCE_INLINE_ bool operator()(const GeometryInstanceSurface *A, const GeometryInstanceSurface *B) const {
 				return (A->sort.sort_key2 == B->sort.sort_key2) ? (A->sort.sort_key1 < B->sort.sort_key1) : (A->sort.sort_key2 < B->sort.sort_key2);
@@ -395,8 +399,23 @@ private:
 		};
 
 		void sort_by_key() {
-			SortArray<GeometryInstanceSurface *, SortByKey> sorter;
-			sorter.sort(elements.ptr(), elements.size());
+			uint32_t count = elements.size();
+			if (count < OPENGL3::RadixSort::MIN_ELEMENTS) {
+				SortArray<GeometryInstanceSurface *, SortByKey> sorter;
+				sorter.sort(elements.ptr(), count);
+				return;
+			}
+
+			// The radix sort is stable, sorting by the low half of the key then by the high half orders by the full 128 bits.
+			sort_keys.resize(count);
+			for (uint32_t i = 0; i < count; i++) {
+				sort_keys[i] = elements[i]->sort.sort_key1;
+			}
+			OPENGL3::RadixSort::sort(sort_keys.ptr(), elements.ptr(), count, sort_tmp_keys, sort_tmp_elements);
+			for (uint32_t i = 0; i < count; i++) {
+				sort_keys[i] = elements[i]->sort.sort_key2;
+			}
+			OPENGL3::RadixSort::sort(sort_keys.ptr(), elements.ptr(), count, sort_tmp_keys, sort_tmp_elements);
 		}
 
 		void sort_by_key_range(uint32_t p_from, uint32_t p_size) {
@@ -423,9 +442,20 @@ private:
 		};
 
 		void sort_by_reverse_depth_and_priority() { //used for alpha
+			uint32_t count = elements.size();
+			if (count < OPENGL3::RadixSort::MIN_ELEMENTS) {
+				SortArray<GeometryInstanceSurface *, SortByReverseDepthAndPriority> sorter;
+				sorter.sort(elements.ptr(), count);
+				return;
+			}
 
-			SortArray<GeometryInstanceSurface *, SortByReverseDepthAndPriority> sorter;
-			sorter.sort(elements.ptr(), elements.size());
+			// Priority in the high bits, inverted depth in the low bits so farther elements come first.
+			sort_keys.resize(count);
+			for (uint32_t i = 0; i < count; i++) {
+				const GeometryInstanceSurface *e = elements[i];
+				sort_keys[i] = (uint64_t(e->sort.priority) << 32) | uint64_t(~OPENGL3::RadixSort::float_to_key(e->owner->depth));
+			}
+			OPENGL3::RadixSort::sort(sort_keys.ptr(), elements.ptr(), count, sort_tmp_keys, sort_tmp_elements);
 		}
 
 		_FORCE_INLINE_ void add_element(GeometryInstanceSurface *p_element) {
@@ -439,9 +469,57 @@ private:
 	void _setup_environment(const RenderDataGLES3 *p_render_data, bool p_no_fog, const Size2i &p_screen_size, bool p_flip_y, const Color &p_default_bg_color, bool p_pancake_shadows);
 	void _fill_render_list(RenderListType p_render_list, const RenderDataGLES3 *p_render_data, PassMode p_pass_mode, bool p_append = false);
 
+	// Large scenes are filled in chunks of instances on the WorkerThreadPool, then merged in order.
+	static const uint32_t FILL_RENDER_LIST_CHUNK_SIZE = 512;
+
+	struct FillRenderListChunk {
+		LocalVector<GeometryInstanceSurface *> elements;
+		LocalVector<GeometryInstanceSurface *> alpha_elements;
+		bool used_screen_texture = false;
+		bool used_normal_texture = false;
+		bool used_depth_texture = false;
+	};
+
+	struct FillRenderListParams {
+		const RenderDataGLES3 *render_data = nullptr;
+		PassMode pass_mode = PASS_MODE_COLOR;
+		Plane near_plane;
+		float z_max = 0.0;
+		bool force_alpha = false;
+		uint32_t chunk_size = 0;
+	} fill_render_list_params;
+
+	bool use_threaded_render_list_fill = true;
+	LocalVector<FillRenderListChunk> fill_render_list_chunks;
+
+	void _fill_render_list_chunk(uint32_t p_chunk, FillRenderListChunk *p_chunks);
+
 	template <PassMode p_pass_mode>
 	_FORCE_INLINE_ void _render_list_template(RenderListParameters *p_params, const RenderDataGLES3 *p_render_data, uint32_t p_from_element, uint32_t p_to_element, bool p_alpha_pass = false);
 
+	/* Auto instancing */
+
+	// Runs of adjacent elements drawing the same surface with the same state are drawn with a single
+	// instanced draw. Their transforms are streamed in the MultiMesh 3D layout, one buffer per frame in flight.
+	static const uint32_t AUTO_INSTANCING_MAX_INSTANCES = 4096;
+	static const uint32_t AUTO_INSTANCING_STRIDE = 16; // Floats, 12 for the transform and 4 for packed color and custom data.
+	static const uint32_t AUTO_INSTANCING_BUFFER_COUNT = 3;
+
+	struct AutoInstancing {
+		bool enabled = true;
+		GLuint buffers[AUTO_INSTANCING_BUFFER_COUNT] = {};
+		uint32_t buffer_sizes[AUTO_INSTANCING_BUFFER_COUNT] = {};
+		GLsync fences[AUTO_INSTANCING_BUFFER_COUNT] = {};
+		uint32_t current_buffer = 0;
+		uint32_t offset = 0; // Bytes already used in the current buffer this frame.
+		uint64_t frame = 0;
+		LocalVector<float> data; // Staging for glBufferSubData on web.
+	} auto_instancing;
+
+	template <PassMode p_pass_mode>
+	uint32_t _auto_instancing_get_run(const RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_to_element) const;
+	GLuint _auto_instancing_upload(const RenderListParameters *p_params, uint32_t p_from_element, uint32_t p_count, uint32_t &r_offset);
+
 protected:
 	double time;
 	double time_step = 0;
@@ -551,6 +629,9 @@ protected:
 public:
 	static RendererSceneRenderGLES3 *get_singleton() { return singleton; }
 
+	void set_threaded_render_list_fill(bool p_enabled) { use_threaded_render_list_fill = p_enabled; }
+	bool is_threaded_render_list_fill() const { return use_threaded_render_list_fill; }
+
 	RendererCanvasRenderGLES3 *canvas = nullptr;
 
 	RenderGeometryInstance *geometry_instance_create(RID p_base) override;
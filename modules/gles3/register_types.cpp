@@ -6,4 +6,23 @@
  */
 #include "register_types.h"
 
-IMPL_SPIKE_MODULE(gles3, SpikeModule)
+#if defined(GLES3_ENABLED) && defined(TOOLS_ENABLED)
+#include "core/config/project_settings.h"
+#include "gles3_benchmark.h"
+#endif
+
+class MODGLES3 : public SpikeModule {
+public:
+	static void scene(bool do_init) {
+#if defined(GLES3_ENABLED) && defined(TOOLS_ENABLED)
+		if (do_init) {
+			GDREGISTER_CLASS(GLES3Benchmark);
+			if (GLES3Benchmark::get_requested_frames() > 0) {
+				ProjectSettings::get_singleton()->set("application/run/main_loop_type", "GLES3Benchmark");
+			}
+		}
+#endif
+	}
+};
+
+IMPL_SPIKE_MODULE(gles3, MODGLES3)
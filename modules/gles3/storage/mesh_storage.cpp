@@ -7,7 +7,10 @@
 #ifdef GLES3_ENABLED
 
 #include "mesh_storage.h"
+#include "core/config/project_settings.h"
+#include "core/object/worker_thread_pool.h"
 #include "drivers/gles3/storage/material_storage.h"
+#include "servers/rendering/rendering_server_globals.h"
 #include "utilities.h"
 
 using namespace OPENGL3;
@@ -20,9 +23,17 @@ MeshStorage *MeshStorage::get_singleton() {
 
 MeshStorage::MeshStorage() {
 	singleton = this;
+
+	skinning_kernel = SkinningKernel(int(GLOBAL_GET("rendering/gl_compatibility/software_skinning/kernel")));
+	software_skinning_set_upload_mode(SkinningUploadMode(int(GLOBAL_GET("rendering/gl_compatibility/software_skinning/upload_mode"))));
 }
 
 MeshStorage::~MeshStorage() {
+	for (uint32_t i = 0; i < MeshInstance::STREAM_BUFFER_COUNT; i++) {
+		if (skinning_frame_fences[i].fence != GLsync()) {
+			glDeleteSync(skinning_frame_fences[i].fence);
+		}
+	}
 	singleton = nullptr;
 }
 
@@ -63,7 +74,6 @@ void MeshStorage::mesh_set_blend_shape_count(RID p_mesh, int p_blend_shape_count
 	ERR_FAIL_COND(!mesh);
 
 	ERR_FAIL_COND(mesh->surface_count > 0); //surfaces already exist
-	WARN_PRINT_ONCE("blend shapes not supported by GLES3 renderer yet");
 	mesh->blend_shape_count = p_blend_shape_count;
 }
 
@@ -74,6 +84,28 @@ bool MeshStorage::mesh_needs_instance(RID p_mesh, bool p_has_skeleton) {
 	return mesh->blend_shape_count > 0 || (mesh->has_bone_weights && p_has_skeleton);
 }
 
+void MeshStorage::_software_skinning_decode(const Mesh::Surface::SoftwareSkinning &p_skinning, const uint8_t *p_vertex_data, uint32_t p_vertex_count, Vector3 *r_vertex, Vector3 *r_normal, Vector3 *r_tangent, float *r_tangent_sign) {
+	for (uint32_t i = 0; i < p_vertex_count; i++) {
+		const uint8_t *src = p_vertex_data + p_skinning.vb_stride * i;
+
+		const float *vertex = (const float *)src;
+		r_vertex[i] = Vector3(vertex[0], vertex[1], vertex[2]);
+
+		if (r_normal) {
+			const uint32_t normal_compressed = *(const uint32_t *)(src + p_skinning.normal_offset);
+			r_normal[i] = Vector3::octahedron_decode(Vector2((normal_compressed & 0xFFFF) / 65535.0, ((normal_compressed >> 16) & 0xFFFF) / 65535.0));
+		}
+		if (r_tangent) {
+			const uint32_t tangent_compressed = *(const uint32_t *)(src + p_skinning.tangent_offset);
+			float sign;
+			r_tangent[i] = Vector3::octahedron_tangent_decode(Vector2((tangent_compressed & 0xFFFF) / 65535.0, ((tangent_compressed >> 16) & 0xFFFF) / 65535.0), &sign);
+			if (r_tangent_sign) {
+				r_tangent_sign[i] = sign;
+			}
+		}
+	}
+}
+
 void MeshStorage::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface) {
 	Mesh *mesh = mesh_owner.get_or_null(p_mesh);
 	ERR_FAIL_COND(!mesh);
@@ -220,83 +252,72 @@ void MeshStorage::mesh_add_surface(RID p_mesh, const RS::SurfaceData &p_surface)
 	//Added by DavidLi
 	//
 	bool is_bone_animation = (p_surface.format & RS::ARRAY_FORMAT_BONES) && (p_surface.format & RS::ARRAY_FORMAT_WEIGHTS);
-	if (is_bone_animation)
-	{
+	bool is_blend_shape = mesh->blend_shape_count > 0 && p_surface.blend_shape_data.size() > 0;
+	if ((is_bone_animation || is_blend_shape) && p_surface.vertex_count > 0 && !(p_surface.format & RS::ARRAY_FLAG_USE_2D_VERTICES)) {
 		//初始化直接用来向GPU提交蒙皮结果的缓冲区
-		s->software_skinning.vb_dest.resize(p_surface.vertex_data.size());
-		uint8_t* vb_dest = s->software_skinning.vb_dest.ptrw();
-		memcpy(vb_dest, p_surface.vertex_data.ptr(), p_surface.vertex_data.size());
+		s->software_skinning.vb_dest = p_surface.vertex_data;
 
 		uint32_t vertex_count = p_surface.vertex_count;
 		uint32_t vertex_buffer_stride = p_surface.vertex_data.size() / vertex_count;
 		s->software_skinning.vb_stride = vertex_buffer_stride;
 
-		s->software_skinning.vertex.resize(vertex_count);
-		Vector3* vertex_w = s->software_skinning.vertex.ptrw();
-
 		bool have_normal = (p_surface.format & RS::ARRAY_FORMAT_NORMAL);
-		Vector3* normal_w = NULL;
-		if (have_normal)
-		{
+		bool have_tangent = (p_surface.format & RS::ARRAY_FORMAT_TANGENT);
+		s->software_skinning.normal_offset = sizeof(float) * 3;
+		s->software_skinning.tangent_offset = s->software_skinning.normal_offset + (have_normal ? sizeof(uint32_t) : 0);
+
+		s->software_skinning.vertex.resize(vertex_count);
+		if (have_normal) {
 			s->software_skinning.normal.resize(vertex_count);
-			normal_w = s->software_skinning.normal.ptrw();
 		}
-
-		bool have_tangent = (p_surface.format & RS::ARRAY_FORMAT_TANGENT);
-		Vector3* tangent_w = NULL;
-		if (have_tangent)
-		{
+		if (have_tangent) {
 			s->software_skinning.tangent.resize(vertex_count);
-			tangent_w = s->software_skinning.tangent.ptrw();
+			s->software_skinning.tangent_sign.resize(vertex_count);
 		}
-
-		uint32_t skin_buffer_stride = p_surface.skin_data.size() / vertex_count;
-		s->software_skinning.bone_indices.resize(vertex_count);
-		Vector4i* bone_indices_w = s->software_skinning.bone_indices.ptrw();
-		s->software_skinning.bone_weights.resize(vertex_count);
-		Vector4* bone_weights_w = s->software_skinning.bone_weights.ptrw();
-		for (uint32_t iVertex = 0; iVertex < vertex_count; ++iVertex)
-		{
-			vertex_w[iVertex] = *(Vector3*)(p_surface.vertex_data.ptr() + vertex_buffer_stride * iVertex);
-
-			if (have_normal)
-			{
-				const uint32_t normal_compressed = *(const uint32_t*)(p_surface.vertex_data.ptr() + vertex_buffer_stride * iVertex + 12);
-				normal_w[iVertex] = Vector3::octahedron_decode(Vector2((normal_compressed & 0xFFFF) / 65535.0, ((normal_compressed >> 16) & 0xFFFF) / 65535.0));
+		_software_skinning_decode(s->software_skinning, p_surface.vertex_data.ptr(), vertex_count, s->software_skinning.vertex.ptrw(), have_normal ? s->software_skinning.normal.ptrw() : nullptr, have_tangent ? s->software_skinning.tangent.ptrw() : nullptr, have_tangent ? s->software_skinning.tangent_sign.ptrw() : nullptr);
+
+		if (is_blend_shape) {
+			// Blend shapes share the vertex buffer format, one full buffer per shape.
+			uint32_t shape_vertex_count = vertex_count * mesh->blend_shape_count;
+			s->software_skinning.blend_vertex.resize(shape_vertex_count);
+			if (have_normal) {
+				s->software_skinning.blend_normal.resize(shape_vertex_count);
 			}
-			if (have_tangent)
-			{
-				const uint32_t tangent_compressed = *(const uint32_t*)(p_surface.vertex_data.ptr() + vertex_buffer_stride * iVertex + 16);
-				tangent_w[iVertex] = Vector3::octahedron_decode(Vector2((tangent_compressed & 0xFFFF) / 65535.0, ((tangent_compressed >> 16) & 0xFFFF) / 65535.0));
+			if (have_tangent) {
+				s->software_skinning.blend_tangent.resize(shape_vertex_count);
 			}
+			for (uint32_t i = 0; i < mesh->blend_shape_count; i++) {
+				uint32_t offset = i * vertex_count;
+				_software_skinning_decode(s->software_skinning, p_surface.blend_shape_data.ptr() + i * p_surface.vertex_data.size(), vertex_count, s->software_skinning.blend_vertex.ptrw() + offset, have_normal ? s->software_skinning.blend_normal.ptrw() + offset : nullptr, have_tangent ? s->software_skinning.blend_tangent.ptrw() + offset : nullptr, nullptr);
+			}
+		}
 
-			bone_indices_w[iVertex].x = *(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 0);
-			bone_indices_w[iVertex].y = *(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 2);
-			bone_indices_w[iVertex].z = *(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 4);
-			bone_indices_w[iVertex].w = *(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 6);
-
-			bone_weights_w[iVertex].x = (float)(*(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 8 + 0)) / 65535.0f;
-			bone_weights_w[iVertex].y = (float)(*(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 8 + 2)) / 65535.0f;
-			bone_weights_w[iVertex].z = (float)(*(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 8 + 4)) / 65535.0f;
-			bone_weights_w[iVertex].w = (float)(*(uint16_t*)(p_surface.skin_data.ptr() + skin_buffer_stride * iVertex + 8 + 6)) / 65535.0f;
+		if (is_bone_animation) {
+			const uint8_t *skin_data = p_surface.skin_data.ptr();
+			uint32_t skin_buffer_stride = p_surface.skin_data.size() / vertex_count;
+			s->software_skinning.bone_indices.resize(vertex_count);
+			Vector4i *bone_indices_w = s->software_skinning.bone_indices.ptrw();
+			s->software_skinning.bone_weights.resize(vertex_count);
+			Vector4 *bone_weights_w = s->software_skinning.bone_weights.ptrw();
+			for (uint32_t iVertex = 0; iVertex < vertex_count; ++iVertex) {
+				const uint16_t *skin = (const uint16_t *)(skin_data + skin_buffer_stride * iVertex);
+
+				bone_indices_w[iVertex] = Vector4i(skin[0], skin[1], skin[2], skin[3]);
+				bone_weights_w[iVertex] = Vector4(skin[4], skin[5], skin[6], skin[7]) / 65535.0f;
+			}
 		}
 
 		bool have_index_buffer = (p_surface.format & RS::ARRAY_FORMAT_INDEX);
-		if (have_index_buffer)
-		{
+		if (have_index_buffer) {
 			uint32_t index_count = p_surface.index_count;
 			uint32_t index_buffer_stride = p_surface.index_data.size() / index_count;
 			s->software_skinning.index.resize(index_count);
-			uint32_t* index_w = s->software_skinning.index.ptrw();
-			for (uint32_t iIndex = 0; iIndex < index_count; ++iIndex)
-			{
-				if (2 == index_buffer_stride)
-				{
-					index_w[iIndex] = *(uint16_t*)(p_surface.index_data.ptr() + index_buffer_stride * iIndex);
-				}
-				else
-				{
-					index_w[iIndex] = *(uint32_t*)(p_surface.index_data.ptr() + index_buffer_stride * iIndex);
+			uint32_t *index_w = s->software_skinning.index.ptrw();
+			for (uint32_t iIndex = 0; iIndex < index_count; ++iIndex) {
+				if (2 == index_buffer_stride) {
+					index_w[iIndex] = *(uint16_t *)(p_surface.index_data.ptr() + index_buffer_stride * iIndex);
+				} else {
+					index_w[iIndex] = *(uint32_t *)(p_surface.index_data.ptr() + index_buffer_stride * iIndex);
 				}
 			}
 		}
@@ -829,6 +850,7 @@ void MeshStorage::_mesh_surface_generate_version_for_input_mask(Mesh::Surface::V
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 
 	v.input_mask = p_input_mask;
+	v.vertex_buffer = mis ? mis->vertex_buffer : 0;
 }
 
 /* MESH INSTANCE API */
@@ -889,6 +911,15 @@ void MeshStorage::_mesh_instance_clear(MeshInstance *mi) {
 			}
 			memfree(mi->surfaces[i].versions);
 		}
+		if (mi->surfaces[i].stream_buffers[0] != 0) {
+			// vertex_buffer is one of the stream buffers.
+			for (uint32_t j = 0; j < MeshInstance::STREAM_BUFFER_COUNT; j++) {
+				if (mi->surfaces[i].stream_buffers[j] != 0) {
+					glDeleteBuffers(1, &mi->surfaces[i].stream_buffers[j]);
+				}
+			}
+			mi->surfaces[i].vertex_buffer = 0;
+		}
 		if (mi->surfaces[i].vertex_buffer != 0) {
 			glDeleteBuffers(1, &mi->surfaces[i].vertex_buffer);
 			mi->surfaces[i].vertex_buffer = 0;
@@ -906,7 +937,7 @@ void MeshStorage::_mesh_instance_clear(MeshInstance *mi) {
 }
 
 void MeshStorage::_mesh_instance_add_surface(MeshInstance *mi, Mesh *mesh, uint32_t p_surface) {
-	if (mesh->blend_shape_count > 0 && mi->blend_weights_buffer == 0) {
+	if (mesh->blend_shape_count > 0 && mi->blend_weights.is_empty()) {
 		mi->blend_weights.resize(mesh->blend_shape_count);
 		for (uint32_t i = 0; i < mi->blend_weights.size(); i++) {
 			mi->blend_weights[i] = 0;
@@ -924,10 +955,22 @@ void MeshStorage::_mesh_instance_add_surface(MeshInstance *mi, Mesh *mesh, uint3
 	}
 
 	//Added by DavidLi
+	Mesh::Surface *surface = mesh->surfaces[p_surface];
 	glGenBuffers(1, &s.vertex_buffer);
 	glBindBuffer(GL_ARRAY_BUFFER, s.vertex_buffer);
 	GLenum usage = GL_DYNAMIC_DRAW;//目前只支持软件蒙皮，必须设置这个
-	glBufferData(GL_ARRAY_BUFFER, mesh->surfaces[p_surface]->vertex_buffer_size, 0, usage);
+	if (!surface->software_skinning.vb_dest.is_empty()) {
+		// Bind pose until the first deformation is uploaded.
+		glBufferData(GL_ARRAY_BUFFER, surface->software_skinning.vb_dest.size(), surface->software_skinning.vb_dest.ptr(), usage);
+	} else {
+		// Nothing deforms this surface, the instance just draws a copy of the mesh data.
+		glBufferData(GL_ARRAY_BUFFER, surface->vertex_buffer_size, nullptr, usage);
+		if (surface->vertex_buffer != 0) {
+			glBindBuffer(GL_COPY_READ_BUFFER, surface->vertex_buffer);
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_ARRAY_BUFFER, 0, 0, surface->vertex_buffer_size);
+			glBindBuffer(GL_COPY_READ_BUFFER, 0);
+		}
+	}
 	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
 
 	mi->surfaces.push_back(s);
@@ -939,8 +982,7 @@ void MeshStorage::mesh_instance_check_for_update(RID p_mesh_instance) {
 
 	bool needs_update = mi->dirty;
 
-	//DavidLi TODO根据条件添加
-	/*if (mi->weights_dirty && !mi->weight_update_list.in_list()) */{
+	if (mi->weights_dirty && !mi->weight_update_list.in_list()) {
 		dirty_mesh_instance_weights.add(&mi->weight_update_list);
 		needs_update = true;
 	}
@@ -958,6 +1000,12 @@ void MeshStorage::mesh_instance_check_for_update(RID p_mesh_instance) {
 
 	if (needs_update) {
 		dirty_mesh_instance_arrays.add(&mi->array_update_list);
+	} else {
+		uint64_t frame = RSG::rasterizer->get_frame_number();
+		if (mi->counted_frame != frame) {
+			mi->counted_frame = frame;
+			Utilities::get_singleton()->render_info_add(Utilities::RENDER_INFO_SKINNING_INSTANCES_SKIPPED, 1);
+		}
 	}
 }
 
@@ -965,73 +1013,187 @@ void MeshStorage::mesh_instance_set_canvas_item_transform(RID p_mesh_instance, c
 
 }
 
-void MeshStorage::update_mesh_instances() {
-	while (dirty_mesh_instance_weights.first()) {
-		MeshInstance *mi = dirty_mesh_instance_weights.first()->self();
+const float *MeshStorage::_skeleton_get_palette(Skeleton *skeleton) {
+	const uint32_t align_floats = SkinningKernels::PALETTE_ALIGNMENT / sizeof(float);
+	const uint32_t palette_size = skeleton->size * SkinningKernels::PALETTE_FLOATS_PER_BONE + align_floats - 1;
+	if (skeleton->palette_version == skeleton->version && skeleton->palette_data.size() == palette_size) {
+		return skeleton->palette;
+	}
 
-		//
-		//Added by DavidLi
-		//
-		Skeleton* skeleton = skeleton_owner.get_or_null(mi->skeleton);
-		if (skeleton)
-		{
-			int sbs = skeleton->size;
-			const float* baseptr = skeleton->es_skeleton_data.ptr();
-			Vector<Transform3D> AllMats;
-			AllMats.resize(sbs);
-			Transform3D* mats_w = AllMats.ptrw();
-			for (int j = 0; j < sbs; j++) {
-				const float* dataptr = baseptr + j * 12;
-
-				Transform3D& mtx = mats_w[j];
-
-				mtx.basis.rows[0][0] = dataptr[0];
-				mtx.basis.rows[0][1] = dataptr[1];
-				mtx.basis.rows[0][2] = dataptr[2];
-				mtx.origin.x = dataptr[3];
-				mtx.basis.rows[1][0] = dataptr[4];
-				mtx.basis.rows[1][1] = dataptr[5];
-				mtx.basis.rows[1][2] = dataptr[6];
-				mtx.origin.y = dataptr[7];
-				mtx.basis.rows[2][0] = dataptr[8];
-				mtx.basis.rows[2][1] = dataptr[9];
-				mtx.basis.rows[2][2] = dataptr[10];
-				mtx.origin.z = dataptr[11];
-			}
+	if (skeleton->palette_data.size() != palette_size) {
+		// Only reallocates when the bone count changes.
+		skeleton->palette_data.resize(palette_size);
+		uintptr_t address = (uintptr_t)skeleton->palette_data.ptr();
+		uintptr_t aligned = (address + SkinningKernels::PALETTE_ALIGNMENT - 1) & ~uintptr_t(SkinningKernels::PALETTE_ALIGNMENT - 1);
+		skeleton->palette = skeleton->palette_data.ptr() + (aligned - address) / sizeof(float);
+	}
+	SkinningKernels::build_palette(skeleton->es_skeleton_data.ptr(), skeleton->size, skeleton->palette);
+	skeleton->palette_version = skeleton->version;
+	return skeleton->palette;
+}
 
-			for (uint32_t iSurface = 0; iSurface < mi->mesh->surface_count; ++ iSurface)
-			{
-				Mesh::Surface* surface = mi->mesh->surfaces[iSurface];
-				Vector3* bind_pos_buffer = surface->software_skinning.vertex.ptrw();
-				uint8_t* vb_dest = surface->software_skinning.vb_dest.ptrw();
-				const Vector4i* bone_indices = surface->software_skinning.bone_indices.ptr();
-				const Vector4* bone_weights = surface->software_skinning.bone_weights.ptr();
-				for (uint32_t iV = 0; iV < surface->vertex_count; ++iV)
-				{
-					Vector3& bind_pos = bind_pos_buffer[iV];
-					Vector3 skinned_pos;
-					for (uint32_t i = 0; i < 4; ++i)
-					{
-						uint32_t iBone = bone_indices[iV][i];
-						const float& bone_weight = bone_weights[iV][i];
-						Transform3D& bone_mat = mats_w[iBone];
-						skinned_pos += bone_mat.xform(bind_pos) * bone_weight;
-					}
-					Vector3& pos_dest = *(Vector3*)&vb_dest[surface->software_skinning.vb_stride * iV];
-					pos_dest = skinned_pos;
-				}
+void MeshStorage::_mesh_instance_add_skinning_jobs(MeshInstance *mi, Skeleton *skeleton) {
+	const float *palette = skeleton ? _skeleton_get_palette(skeleton) : nullptr;
 
-				glBindBuffer(GL_ARRAY_BUFFER, mi->surfaces[iSurface].vertex_buffer);
-				GLenum usage = GL_DYNAMIC_DRAW;//软件蒙皮，必须设置这个
-				glBufferData(GL_ARRAY_BUFFER, surface->software_skinning.vb_dest.size(), vb_dest, usage);
-				//(surface->format & RS::ARRAY_FLAG_USE_DYNAMIC_UPDATE) ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
-				glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
-			}
+	const bool use_blend_shapes = mi->mesh->blend_shape_count > 0 && mi->blend_weights.size() == mi->mesh->blend_shape_count;
+
+	for (uint32_t i = 0; i < mi->mesh->surface_count; i++) {
+		const Mesh::Surface::SoftwareSkinning &skinning = mi->mesh->surfaces[i]->software_skinning;
+		const bool skinned = palette && !skinning.bone_indices.is_empty();
+		const bool blended = use_blend_shapes && !skinning.blend_vertex.is_empty();
+		if (!skinned && !blended) {
+			continue;
 		}
-		//
-		//End: Added by DavidLi
-		//
 
+		MeshInstance::Surface &mis = mi->surfaces[i];
+		uint8_t *dst = _mesh_instance_surface_begin_upload(mis, skinning);
+		skinning_surfaces.push_back(&mis);
+
+		SkinningJob job;
+		job.mi = mi;
+
+		SkinningKernels::DeformInput &input = job.input;
+		input.vertex_count = skinning.vertex.size();
+		input.vertices = skinning.vertex.ptr();
+		input.normals = skinning.normal.is_empty() ? nullptr : skinning.normal.ptr();
+		input.tangents = skinning.tangent.is_empty() ? nullptr : skinning.tangent.ptr();
+		input.tangent_signs = skinning.tangent_sign.ptr();
+		if (skinned) {
+			input.palette = palette;
+			input.bone_indices = skinning.bone_indices.ptr();
+			input.bone_weights = skinning.bone_weights.ptr();
+		}
+		if (blended) {
+			input.blend_vertices = skinning.blend_vertex.ptr();
+			input.blend_normals = skinning.blend_normal.ptr();
+			input.blend_tangents = skinning.blend_tangent.ptr();
+			input.blend_weights = mi->blend_weights.ptr();
+			input.blend_shape_count = mi->mesh->blend_shape_count;
+			input.blend_normalized = mi->mesh->blend_shape_mode == RS::BLEND_SHAPE_MODE_NORMALIZED;
+		}
+		input.dst = dst;
+		input.dst_stride = skinning.vb_stride;
+		input.normal_offset = skinning.normal_offset;
+		input.tangent_offset = skinning.tangent_offset;
+
+		for (uint32_t from = 0; from < input.vertex_count; from += SKINNING_JOB_VERTEX_COUNT) {
+			job.from = from;
+			job.to = MIN(from + SKINNING_JOB_VERTEX_COUNT, input.vertex_count);
+			skinning_jobs.push_back(job);
+		}
+	}
+}
+
+void MeshStorage::_skinning_job_process(uint32_t p_index, SkinningJob *p_jobs) {
+	const SkinningJob &job = p_jobs[p_index];
+	SkinningKernels::deform(job.input, job.from, job.to, skinning_frame_kernel == SKINNING_KERNEL_PARALLEL_SIMD);
+}
+
+uint8_t *MeshStorage::_mesh_instance_surface_begin_upload(MeshInstance::Surface &mis, const Mesh::Surface::SoftwareSkinning &p_skinning) {
+	uint32_t data_size = p_skinning.vb_dest.size();
+
+	if (skinning_upload_mode == SKINNING_UPLOAD_BUFFER_DATA) {
+		if (mis.skinned_data.size() != data_size) {
+			// Attributes the kernels don't write keep their bind pose value.
+			mis.skinned_data.resize(data_size);
+			memcpy(mis.skinned_data.ptr(), p_skinning.vb_dest.ptr(), data_size);
+		}
+		return mis.skinned_data.ptr();
+	}
+
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+
+	if (mis.stream_buffers[0] == 0) {
+		// The buffer created with the instance holds the bind pose and becomes the first stream buffer.
+		mis.stream_buffers[0] = mis.vertex_buffer;
+		glGenBuffers(MeshInstance::STREAM_BUFFER_COUNT - 1, &mis.stream_buffers[1]);
+		for (uint32_t i = 1; i < MeshInstance::STREAM_BUFFER_COUNT; i++) {
+			glBindBuffer(GL_ARRAY_BUFFER, mis.stream_buffers[i]);
+			glBufferData(GL_ARRAY_BUFFER, data_size, nullptr, GL_DYNAMIC_DRAW);
+		}
+		mis.stream_buffer_index = 0;
+		mis.stream_size = data_size;
+	}
+
+	// The current buffer may be drawn until now, rotate to the oldest one.
+	mis.stream_buffer_frame[mis.stream_buffer_index] = frame;
+	mis.stream_buffer_index = (mis.stream_buffer_index + 1) % MeshInstance::STREAM_BUFFER_COUNT;
+	mis.vertex_buffer = mis.stream_buffers[mis.stream_buffer_index];
+
+	glBindBuffer(GL_ARRAY_BUFFER, mis.vertex_buffer);
+	GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT;
+	if (_skinning_wait_for_frame(mis.stream_buffer_frame[mis.stream_buffer_index])) {
+		access |= GL_MAP_UNSYNCHRONIZED_BIT;
+	}
+	// Without the unsynchronized bit the driver orphans the storage if it is still in use, like glBufferData would.
+	mis.stream_mapped = static_cast<uint8_t *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, mis.stream_size, access));
+	if (mis.stream_mapped == nullptr) {
+		// Mapping failed, deform into the CPU copy and upload it like the buffer data mode does.
+		if (mis.skinned_data.size() != data_size) {
+			mis.skinned_data.resize(data_size);
+			memcpy(mis.skinned_data.ptr(), p_skinning.vb_dest.ptr(), data_size);
+		}
+		return mis.skinned_data.ptr();
+	}
+	return mis.stream_mapped;
+}
+
+void MeshStorage::_mesh_instance_surface_end_upload(MeshInstance::Surface &mis) {
+	glBindBuffer(GL_ARRAY_BUFFER, mis.vertex_buffer);
+	if (mis.stream_mapped) {
+		glUnmapBuffer(GL_ARRAY_BUFFER);
+		mis.stream_mapped = nullptr;
+	} else {
+		glBufferData(GL_ARRAY_BUFFER, mis.skinned_data.size(), mis.skinned_data.ptr(), GL_DYNAMIC_DRAW);
+	}
+}
+
+bool MeshStorage::_skinning_wait_for_frame(uint64_t p_frame) {
+	if (p_frame == 0) {
+		return true; // Never drawn.
+	}
+	// Fences are signaled in order, so a fence of a later frame is as good.
+	const SkinningFrameFence &ff = skinning_frame_fences[p_frame % MeshInstance::STREAM_BUFFER_COUNT];
+	if (ff.fence == GLsync() || ff.frame < p_frame) {
+		return false; // The frame has not ended yet.
+	}
+	GLenum status = glClientWaitSync(ff.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	if (status == GL_TIMEOUT_EXPIRED) {
+		// Frames that old are usually done, wait for up to 100ms like the canvas renderer does.
+		status = glClientWaitSync(ff.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000);
+	}
+	return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void MeshStorage::software_skinning_set_kernel(SkinningKernel p_kernel) {
+	ERR_FAIL_INDEX(p_kernel, SKINNING_KERNEL_PARALLEL_SIMD + 1);
+	skinning_kernel = p_kernel;
+}
+
+void MeshStorage::software_skinning_set_upload_mode(SkinningUploadMode p_mode) {
+#ifdef WEB_ENABLED
+	// WebGL can't map buffers.
+	p_mode = SKINNING_UPLOAD_BUFFER_DATA;
+#endif
+	skinning_upload_mode = p_mode;
+}
+
+void MeshStorage::software_skinning_end_frame() {
+	if (skinning_upload_mode != SKINNING_UPLOAD_STREAMING) {
+		return;
+	}
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+	SkinningFrameFence &ff = skinning_frame_fences[frame % MeshInstance::STREAM_BUFFER_COUNT];
+	if (ff.fence != GLsync()) {
+		glDeleteSync(ff.fence);
+	}
+	ff.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	ff.frame = frame;
+}
+
+void MeshStorage::update_mesh_instances() {
+	while (dirty_mesh_instance_weights.first()) {
+		MeshInstance *mi = dirty_mesh_instance_weights.first()->self();
 
 		if (mi->blend_weights_buffer != 0) {
 			//RD::get_singleton()->buffer_update(mi->blend_weights_buffer, 0, mi->blend_weights.size() * sizeof(float), mi->blend_weights.ptr());
@@ -1043,8 +1205,51 @@ void MeshStorage::update_mesh_instances() {
 		return; //nothing to do
 	}
 
-	// Process skeletons and blend shapes using transform feedback
-	// TODO: Implement when working on skeletons and blend shapes
+	uint64_t frame = RSG::rasterizer->get_frame_number();
+	uint32_t processed = 0;
+	while (dirty_mesh_instance_arrays.first()) {
+		MeshInstance *mi = dirty_mesh_instance_arrays.first()->self();
+
+		Skeleton *skeleton = skeleton_owner.get_or_null(mi->skeleton);
+		if (skeleton && (skeleton->size == 0 || skeleton->use_2d)) {
+			skeleton = nullptr;
+		}
+		if (skeleton || mi->mesh->blend_shape_count > 0) {
+			_mesh_instance_add_skinning_jobs(mi, skeleton);
+			if (mi->counted_frame != frame) {
+				mi->counted_frame = frame;
+				processed++;
+			}
+		}
+		if (skeleton) {
+			mi->skeleton_version = skeleton->version;
+		}
+
+		dirty_mesh_instance_arrays.remove(&mi->array_update_list);
+		mi->dirty = false;
+	}
+	Utilities::get_singleton()->render_info_add(Utilities::RENDER_INFO_SKINNING_INSTANCES_PROCESSED, processed);
+
+	skinning_frame_kernel = skinning_kernel;
+	if (skinning_frame_kernel == SKINNING_KERNEL_SCALAR) {
+		for (uint32_t i = 0; i < skinning_jobs.size(); i++) {
+			_skinning_job_process(i, skinning_jobs.ptr());
+		}
+	} else if (skinning_jobs.size() > 1) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_template_group_task(this, &MeshStorage::_skinning_job_process, skinning_jobs.ptr(), skinning_jobs.size(), -1, true, "SoftwareSkinning");
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else if (skinning_jobs.size() == 1) {
+		_skinning_job_process(0, skinning_jobs.ptr());
+	}
+
+	// GL calls must stay on the render thread, unmap or upload once every job is done.
+	for (MeshInstance::Surface *mis : skinning_surfaces) {
+		_mesh_instance_surface_end_upload(*mis);
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, 0); //unbind
+
+	skinning_jobs.clear();
+	skinning_surfaces.clear();
 }
 
 /* MULTIMESH API */
@@ -1823,6 +2028,22 @@ Transform2D MeshStorage::skeleton_bone_get_transform_2d(RID p_skeleton, int p_bo
 void MeshStorage::skeleton_update_dependency(RID p_base, DependencyTracker *p_instance) {
 }
 
+void MeshStorage::_update_dirty_skeletons() {
+	while (skeleton_dirty_list) {
+		Skeleton *skeleton = skeleton_dirty_list;
+
+		skeleton_dirty_list = skeleton->dirty_list;
+
+		// Mesh instances compare against this to know whether they need to be skinned again.
+		skeleton->version++;
+
+		skeleton->dirty = false;
+		skeleton->dirty_list = nullptr;
+	}
+
+	skeleton_dirty_list = nullptr;
+}
+
 /* OCCLUDER */
 
 void MeshStorage::occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices) {
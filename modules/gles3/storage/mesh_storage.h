@@ -14,6 +14,7 @@
 #include "core/templates/self_list.h"
 #include "servers/rendering/storage/mesh_storage.h"
 #include "servers/rendering/storage/utilities.h"
+#include "skinning_kernels.h"
 
 #include "platform_config.h"
 #ifndef OPENGL_INCLUDE_H
@@ -45,12 +46,20 @@ struct Mesh {
 			Vector<Vector3> vertex; // Vertex
 			Vector<Vector3> normal; // Normal
 			Vector<Vector3> tangent; // Tangent
+			Vector<float> tangent_sign; // Binormal sign, encoded back with the tangent
 			Vector<uint8_t> vb_dest; // 存储vertex、normal、tangent，压缩格式，直接提交到GPU
 			uint32_t vb_stride;
+			uint32_t normal_offset = 0;
+			uint32_t tangent_offset = 0;
 
 			Vector<Vector4i> bone_indices;
 			Vector<Vector4> bone_weights;
 			Vector<uint32_t> index;//顶点索引
+
+			// Blend shape targets, decoded like the bind pose, blend_shape_count * vertex_count entries.
+			Vector<Vector3> blend_vertex;
+			Vector<Vector3> blend_normal;
+			Vector<Vector3> blend_tangent;
 		} software_skinning;
 
 		GLuint vertex_buffer = 0;
@@ -65,6 +74,7 @@ struct Mesh {
 		struct Version {
 			uint32_t input_mask = 0;
 			GLuint vertex_array = 0;
+			GLuint vertex_buffer = 0; // Mesh instances only, the streamed buffer this array reads from.
 
 			Attrib attribs[RS::ARRAY_MAX];
 		};
@@ -124,11 +134,24 @@ struct Mesh {
 struct MeshInstance {
 	Mesh *mesh = nullptr;
 	RID skeleton;
+	enum {
+		STREAM_BUFFER_COUNT = 3, // OpenGL can have up to 3 frames in flight.
+	};
+
 	struct Surface {
-		GLuint vertex_buffer = 0;
+		GLuint vertex_buffer = 0; // Buffer drawn from, one of stream_buffers once the surface is streamed.
 
 		Mesh::Surface::Version *versions = nullptr; //allocated on demand
 		uint32_t version_count = 0;
+
+		LocalVector<uint8_t> skinned_data; // Per instance copy of vb_dest, written by the deform kernels.
+
+		// Streaming upload, deformed vertices are written straight into a mapped buffer that is not in flight.
+		GLuint stream_buffers[STREAM_BUFFER_COUNT] = {};
+		uint64_t stream_buffer_frame[STREAM_BUFFER_COUNT] = {}; // Last frame each buffer could be drawn in.
+		uint32_t stream_buffer_index = 0;
+		uint32_t stream_size = 0;
+		uint8_t *stream_mapped = nullptr;
 	};
 	LocalVector<Surface> surfaces;
 	LocalVector<float> blend_weights;
@@ -136,6 +159,9 @@ struct MeshInstance {
 	GLuint blend_weights_buffer = 0;
 	List<MeshInstance *>::Element *I = nullptr; //used to erase itself
 	uint64_t skeleton_version = 0;
+	// Frame this instance was last counted as processed or skipped in the render info.
+	// mesh_instance_check_for_update() runs for every cull pass and canvas draw, an instance is counted once per frame.
+	uint64_t counted_frame = UINT64_MAX;
 	bool dirty = false;
 	bool weights_dirty = false;
 	SelfList<MeshInstance> weight_update_list;
@@ -184,6 +210,12 @@ struct Skeleton {
 
 	uint64_t version = 1;
 
+	// Bones in SkinningKernels palette layout, shared by every mesh instance using this skeleton.
+	// palette_data is over-allocated so that palette starts on a SkinningKernels::PALETTE_ALIGNMENT boundary.
+	LocalVector<float> palette_data;
+	float *palette = nullptr;
+	uint64_t palette_version = 0;
+
 	Dependency dependency;
 };
 
@@ -195,6 +227,7 @@ private:
 
 	mutable RID_Owner<Mesh, true> mesh_owner;
 
+	void _software_skinning_decode(const Mesh::Surface::SoftwareSkinning &p_skinning, const uint8_t *p_vertex_data, uint32_t p_vertex_count, Vector3 *r_vertex, Vector3 *r_normal, Vector3 *r_tangent, float *r_tangent_sign);
 	void _mesh_surface_generate_version_for_input_mask(Mesh::Surface::Version &v, Mesh::Surface *s, uint32_t p_input_mask, MeshInstance::Surface *mis = nullptr);
 
 	/* Mesh Instance API */
@@ -206,6 +239,51 @@ private:
 	SelfList<MeshInstance>::List dirty_mesh_instance_weights;
 	SelfList<MeshInstance>::List dirty_mesh_instance_arrays;
 
+	/* Software Skinning */
+
+public:
+	enum SkinningKernel {
+		SKINNING_KERNEL_SCALAR,
+		SKINNING_KERNEL_PARALLEL_SIMD,
+	};
+
+	enum SkinningUploadMode {
+		SKINNING_UPLOAD_BUFFER_DATA,
+		SKINNING_UPLOAD_STREAMING,
+	};
+
+private:
+	// Surfaces with more vertices than this are split into several jobs.
+	static const uint32_t SKINNING_JOB_VERTEX_COUNT = 4096;
+
+	struct SkinningJob {
+		MeshInstance *mi = nullptr;
+		SkinningKernels::DeformInput input;
+		uint32_t from = 0;
+		uint32_t to = 0;
+	};
+
+	// Can be switched from the main thread at any time, update_mesh_instances() uses it for the whole frame as skinning_frame_kernel.
+	SkinningKernel skinning_kernel = SKINNING_KERNEL_PARALLEL_SIMD;
+	SkinningKernel skinning_frame_kernel = SKINNING_KERNEL_PARALLEL_SIMD;
+	SkinningUploadMode skinning_upload_mode = SKINNING_UPLOAD_STREAMING;
+	LocalVector<SkinningJob> skinning_jobs;
+	LocalVector<MeshInstance::Surface *> skinning_surfaces;
+
+	// Fence at the end of each frame, used to know when a stream buffer is no longer read by the GPU.
+	struct SkinningFrameFence {
+		GLsync fence = GLsync();
+		uint64_t frame = 0;
+	};
+	SkinningFrameFence skinning_frame_fences[MeshInstance::STREAM_BUFFER_COUNT];
+
+	const float *_skeleton_get_palette(Skeleton *skeleton);
+	void _mesh_instance_add_skinning_jobs(MeshInstance *mi, Skeleton *skeleton);
+	void _skinning_job_process(uint32_t p_index, SkinningJob *p_jobs);
+	uint8_t *_mesh_instance_surface_begin_upload(MeshInstance::Surface &mis, const Mesh::Surface::SoftwareSkinning &p_skinning);
+	void _mesh_instance_surface_end_upload(MeshInstance::Surface &mis);
+	bool _skinning_wait_for_frame(uint64_t p_frame);
+
 	/* MultiMesh */
 
 	mutable RID_Owner<MultiMesh, true> multimesh_owner;
@@ -393,6 +471,12 @@ public:
 	virtual void mesh_instance_set_canvas_item_transform(RID p_mesh_instance, const Transform2D &p_transform) override;
 	virtual void update_mesh_instances() override;
 
+	void software_skinning_set_kernel(SkinningKernel p_kernel);
+	SkinningKernel software_skinning_get_kernel() const { return skinning_kernel; }
+	void software_skinning_set_upload_mode(SkinningUploadMode p_mode);
+	SkinningUploadMode software_skinning_get_upload_mode() const { return skinning_upload_mode; }
+	void software_skinning_end_frame();
+
 	_FORCE_INLINE_ void mesh_instance_surface_get_vertex_arrays_and_format(RID p_mesh_instance, uint32_t p_surface_index, uint32_t p_input_mask, GLuint &r_vertex_array_gl) {
 		MeshInstance *mi = mesh_instance_owner.get_or_null(p_mesh_instance);
 		ERR_FAIL_COND(!mi);
@@ -404,10 +488,10 @@ public:
 
 		s->version_lock.lock();
 
-		//there will never be more than, at much, 3 or 4 versions, so iterating is the fastest way
+		//there will never be more than, at much, 3 or 4 versions per stream buffer, so iterating is the fastest way
 
 		for (uint32_t i = 0; i < mis->version_count; i++) {
-			if (mis->versions[i].input_mask != p_input_mask) {
+			if (mis->versions[i].input_mask != p_input_mask || mis->versions[i].vertex_buffer != mis->vertex_buffer) {
 				continue;
 			}
 			//we have this version, hooray
@@ -521,6 +605,8 @@ public:
 
 	virtual void skeleton_update_dependency(RID p_base, DependencyTracker *p_instance) override;
 
+	void _update_dirty_skeletons();
+
 	/* OCCLUDER */
 
 	void occluder_set_mesh(RID p_occluder, const PackedVector3Array &p_vertices, const PackedInt32Array &p_indices);
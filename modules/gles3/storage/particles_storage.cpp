@@ -9,6 +9,7 @@
 #include "particles_storage.h"
 #include "drivers/gles3/storage/material_storage.h"
 #include "mesh_storage.h"
+#include "radix_sort.h"
 #include "drivers/gles3/storage/texture_storage.h"
 #include "utilities.h"
 
@@ -741,9 +742,7 @@ void ParticlesStorage::particles_set_view_axis(RID p_particles, const Vector3 &p
 		particle_array = particle_vector.ptr();
 		glGetBufferSubData(GL_ARRAY_BUFFER, 0, particles->amount * sizeof(ParticleInstanceData3D), particle_array);
 #endif
-		SortArray<ParticleInstanceData3D, ParticlesViewSort> sorter;
-		sorter.compare.z_dir = axis;
-		sorter.sort(particle_array, particles->amount);
+		_particles_sort_by_view_depth(particle_array, particles->amount, axis);
 
 #ifndef __EMSCRIPTEN__
 		glUnmapBuffer(GL_ARRAY_BUFFER);
@@ -757,6 +756,31 @@ void ParticlesStorage::particles_set_view_axis(RID p_particles, const Vector3 &p
 	glDisable(GL_RASTERIZER_DISCARD);
 }
 
+void ParticlesStorage::_particles_sort_by_view_depth(ParticleInstanceData3D *p_particle_array, uint32_t p_amount, const Vector3 &p_axis) {
+	if (p_amount < RadixSort::MIN_ELEMENTS) {
+		SortArray<ParticleInstanceData3D, ParticlesViewSort> sorter;
+		sorter.compare.z_dir = p_axis;
+		sorter.sort(p_particle_array, p_amount);
+		return;
+	}
+
+	// Sort indices rather than moving the particles around on every pass, then gather once.
+	view_sort_keys.resize(p_amount);
+	view_sort_indices.resize(p_amount);
+	for (uint32_t i = 0; i < p_amount; i++) {
+		const float *xform = p_particle_array[i].xform;
+		view_sort_keys[i] = RadixSort::float_to_key(p_axis.dot(Vector3(xform[3], xform[7], xform[11])));
+		view_sort_indices[i] = i;
+	}
+	RadixSort::sort(view_sort_keys.ptr(), view_sort_indices.ptr(), p_amount, view_sort_tmp_keys, view_sort_tmp_indices);
+
+	view_sort_particles.resize(p_amount);
+	memcpy(view_sort_particles.ptr(), p_particle_array, p_amount * sizeof(ParticleInstanceData3D));
+	for (uint32_t i = 0; i < p_amount; i++) {
+		p_particle_array[i] = view_sort_particles[view_sort_indices[i]];
+	}
+}
+
 void ParticlesStorage::_particles_update_buffers(Particles *particles) {
 	GLES3::MaterialStorage *material_storage = GLES3::MaterialStorage::get_singleton();
 	uint32_t userdata_count = 0;
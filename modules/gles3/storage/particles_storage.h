@@ -227,6 +227,15 @@ private:
 	void _particles_allocate_history_buffers(Particles *particles);
 	void _particles_update_instance_buffer(Particles *particles, const Vector3 &p_axis, const Vector3 &p_up_axis);
 
+	// View depth sort scratch, kept between frames.
+	LocalVector<uint32_t> view_sort_keys;
+	LocalVector<uint32_t> view_sort_tmp_keys;
+	LocalVector<uint32_t> view_sort_indices;
+	LocalVector<uint32_t> view_sort_tmp_indices;
+	LocalVector<ParticleInstanceData3D> view_sort_particles;
+
+	void _particles_sort_by_view_depth(ParticleInstanceData3D *p_particle_array, uint32_t p_amount, const Vector3 &p_axis);
+
 	template <typename T>
 	void _particles_reverse_lifetime_sort(Particles *particles);
 
@@ -0,0 +1,106 @@
+/**
+ * radix_sort.h
+ *
+ * This file is part of Spike engine, a modification and extension of Godot.
+ *
+ */
+#pragma once
+
+#ifdef GLES3_ENABLED
+
+#include "core/templates/local_vector.h"
+#include "core/typedefs.h"
+
+#include <string.h>
+
+namespace OPENGL3 {
+
+// Stable LSD radix sort over unsigned integer keys, one byte per pass.
+//
+// All histograms are built in a single read of the keys and passes where every
+// key has the same byte are skipped, so keys that only use a few of their bits
+// (sort keys with constant fields, depths in a narrow range) cost a few passes.
+// Below MIN_ELEMENTS a comparison sort is faster, callers are expected to check.
+class RadixSort {
+public:
+	enum {
+		MIN_ELEMENTS = 256,
+	};
+
+	// Maps a float to a key with the same ordering (negative values included).
+	static _FORCE_INLINE_ uint32_t float_to_key(float p_value) {
+		uint32_t bits;
+		memcpy(&bits, &p_value, sizeof(uint32_t));
+		uint32_t mask = (bits & 0x80000000) ? 0xFFFFFFFF : 0x80000000;
+		return bits ^ mask;
+	}
+
+	// Sorts `p_keys` in ascending order and applies the same permutation to `p_items`.
+	// `r_tmp_keys` and `r_tmp_items` are scratch, resized as needed and meant to be kept around between calls.
+	template <class K, class T>
+	static void sort(K *p_keys, T *p_items, uint32_t p_count, LocalVector<K> &r_tmp_keys, LocalVector<T> &r_tmp_items) {
+		if (p_count < 2) {
+			return;
+		}
+
+		const uint32_t passes = sizeof(K);
+		uint32_t histograms[passes][256];
+		memset(histograms, 0, sizeof(histograms));
+
+		for (uint32_t i = 0; i < p_count; i++) {
+			K key = p_keys[i];
+			for (uint32_t p = 0; p < passes; p++) {
+				histograms[p][(key >> (p * 8)) & 0xFF]++;
+			}
+		}
+
+		if (r_tmp_keys.size() < p_count) {
+			r_tmp_keys.resize(p_count);
+		}
+		if (r_tmp_items.size() < p_count) {
+			r_tmp_items.resize(p_count);
+		}
+
+		K *src_keys = p_keys;
+		T *src_items = p_items;
+		K *dst_keys = r_tmp_keys.ptr();
+		T *dst_items = r_tmp_items.ptr();
+
+		for (uint32_t p = 0; p < passes; p++) {
+			uint32_t *histogram = histograms[p];
+			const uint32_t shift = p * 8;
+
+			if (histogram[(src_keys[0] >> shift) & 0xFF] == p_count) {
+				continue; // Same byte everywhere, this pass would not move anything.
+			}
+
+			uint32_t offset = 0;
+			for (uint32_t b = 0; b < 256; b++) {
+				uint32_t count = histogram[b];
+				histogram[b] = offset;
+				offset += count;
+			}
+
+			for (uint32_t i = 0; i < p_count; i++) {
+				uint32_t dst = histogram[(src_keys[i] >> shift) & 0xFF]++;
+				dst_keys[dst] = src_keys[i];
+				dst_items[dst] = src_items[i];
+			}
+
+			SWAP(src_keys, dst_keys);
+			SWAP(src_items, dst_items);
+		}
+
+		if (src_keys != p_keys) {
+			// Odd number of passes, the result is in the scratch buffers.
+			memcpy(p_keys, src_keys, p_count * sizeof(K));
+			for (uint32_t i = 0; i < p_count; i++) {
+				p_items[i] = src_items[i];
+			}
+		}
+	}
+};
+
+} // namespace OPENGL3
+
+#endif // GLES3_ENABLED
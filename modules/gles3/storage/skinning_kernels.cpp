@@ -0,0 +1,299 @@
+/**
+ * skinning_kernels.cpp
+ *
+ * This file is part of Spike engine, a modification and extension of Godot.
+ *
+ */
+#ifdef GLES3_ENABLED
+
+#include "skinning_kernels.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SKINNING_SSE
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SKINNING_NEON
+#include <arm_neon.h>
+#endif
+
+using namespace OPENGL3;
+
+#if defined(SKINNING_SSE)
+typedef __m128 simd4;
+#define SIMD_LOAD(p) _mm_load_ps(p)
+#define SIMD_STORE(p, v) _mm_storeu_ps(p, v)
+#define SIMD_SPLAT(f) _mm_set1_ps(f)
+#define SIMD_MUL(a, b) _mm_mul_ps(a, b)
+#define SIMD_MADD(a, b, c) _mm_add_ps(a, _mm_mul_ps(b, c)) // a + b * c
+#elif defined(SKINNING_NEON)
+typedef float32x4_t simd4;
+#define SIMD_LOAD(p) vld1q_f32(p)
+#define SIMD_STORE(p, v) vst1q_f32(p, v)
+#define SIMD_SPLAT(f) vdupq_n_f32(f)
+#define SIMD_MUL(a, b) vmulq_f32(a, b)
+#define SIMD_MADD(a, b, c) vmlaq_f32(a, b, c) // a + b * c
+#endif
+
+void SkinningKernels::build_palette(const float *p_skeleton_data, uint32_t p_bone_count, float *r_palette) {
+	for (uint32_t i = 0; i < p_bone_count; i++) {
+		const float *src = p_skeleton_data + i * 12;
+		float *dst = r_palette + i * PALETTE_FLOATS_PER_BONE;
+
+		for (uint32_t c = 0; c < 4; c++) {
+			dst[c * 4 + 0] = src[c];
+			dst[c * 4 + 1] = src[4 + c];
+			dst[c * 4 + 2] = src[8 + c];
+			dst[c * 4 + 3] = 0.0;
+		}
+	}
+}
+
+static _FORCE_INLINE_ uint32_t _encode_octahedron(const Vector2 &p_oct) {
+	return uint32_t(CLAMP(p_oct.x * 65535, 0, 65535)) | (uint32_t(CLAMP(p_oct.y * 65535, 0, 65535)) << 16);
+}
+
+static _FORCE_INLINE_ void _write_vertex(const SkinningKernels::DeformInput &p_input, uint8_t *r_dst, const float *p_vertex, const float *p_normal, const float *p_tangent, float p_tangent_sign) {
+	memcpy(r_dst, p_vertex, sizeof(float) * 3);
+
+	if (p_normal) {
+		Vector3 normal(p_normal[0], p_normal[1], p_normal[2]);
+		if (normal.is_zero_approx()) {
+			normal = Vector3(0, 0, 1);
+		}
+		uint32_t encoded = _encode_octahedron(normal.octahedron_encode());
+		memcpy(r_dst + p_input.normal_offset, &encoded, sizeof(uint32_t));
+	}
+
+	if (p_tangent) {
+		Vector3 tangent(p_tangent[0], p_tangent[1], p_tangent[2]);
+		if (tangent.is_zero_approx()) {
+			tangent = Vector3(1, 0, 0);
+		}
+		uint32_t encoded = _encode_octahedron(tangent.octahedron_tangent_encode(p_tangent_sign));
+		memcpy(r_dst + p_input.tangent_offset, &encoded, sizeof(uint32_t));
+	}
+}
+
+// Blends vertices [p_from, p_from + p_count) into the scratch arrays, the same way the RD skeleton shader does.
+static void _blend_block(const SkinningKernels::DeformInput &p_input, uint32_t p_from, uint32_t p_count, Vector3 *r_vertices, Vector3 *r_normals, Vector3 *r_tangents) {
+	float total = 0.0;
+	for (uint32_t i = 0; i < p_input.blend_shape_count; i++) {
+		total += p_input.blend_weights[i];
+	}
+	const float base = p_input.blend_normalized ? 1.0 - total : 1.0;
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		r_vertices[i] = p_input.vertices[p_from + i] * base;
+	}
+	if (r_normals) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_normals[i] = p_input.normals[p_from + i] * base;
+		}
+	}
+	if (r_tangents) {
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_tangents[i] = p_input.tangents[p_from + i] * base;
+		}
+	}
+
+	for (uint32_t s = 0; s < p_input.blend_shape_count; s++) {
+		const float w = p_input.blend_weights[s];
+		if (Math::abs(w) < 0.0001) {
+			continue;
+		}
+		const uint32_t offset = s * p_input.vertex_count + p_from;
+
+		const Vector3 *shape_vertices = p_input.blend_vertices + offset;
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_vertices[i] += shape_vertices[i] * w;
+		}
+		if (r_normals) {
+			const Vector3 *shape_normals = p_input.blend_normals + offset;
+			for (uint32_t i = 0; i < p_count; i++) {
+				r_normals[i] += shape_normals[i] * w;
+			}
+		}
+		if (r_tangents) {
+			const Vector3 *shape_tangents = p_input.blend_tangents + offset;
+			for (uint32_t i = 0; i < p_count; i++) {
+				r_tangents[i] += shape_tangents[i] * w;
+			}
+		}
+	}
+}
+
+static void _copy_block(const SkinningKernels::DeformInput &p_input, uint32_t p_from, uint32_t p_count, const Vector3 *p_vertices, const Vector3 *p_normals, const Vector3 *p_tangents) {
+	float vertex[3];
+	float normal[3];
+	float tangent[3];
+	for (uint32_t i = 0; i < p_count; i++) {
+		vertex[0] = p_vertices[i].x;
+		vertex[1] = p_vertices[i].y;
+		vertex[2] = p_vertices[i].z;
+		if (p_normals) {
+			normal[0] = p_normals[i].x;
+			normal[1] = p_normals[i].y;
+			normal[2] = p_normals[i].z;
+		}
+		if (p_tangents) {
+			tangent[0] = p_tangents[i].x;
+			tangent[1] = p_tangents[i].y;
+			tangent[2] = p_tangents[i].z;
+		}
+		_write_vertex(p_input, p_input.dst + (p_from + i) * p_input.dst_stride, vertex, p_normals ? normal : nullptr, p_tangents ? tangent : nullptr, p_tangents ? p_input.tangent_signs[p_from + i] : 1.0);
+	}
+}
+
+static void _skin_block_scalar(const SkinningKernels::DeformInput &p_input, uint32_t p_from, uint32_t p_count, const Vector3 *p_vertices, const Vector3 *p_normals, const Vector3 *p_tangents) {
+	float vertex[3];
+	float normal[3];
+	float tangent[3];
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector4i &bones = p_input.bone_indices[p_from + i];
+		const Vector4 &weights = p_input.bone_weights[p_from + i];
+
+		// Blended 3x4 matrix, stored by columns.
+		float m[12] = {};
+		for (uint32_t j = 0; j < 4; j++) {
+			const float *b = p_input.palette + bones[j] * SkinningKernels::PALETTE_FLOATS_PER_BONE;
+			const float w = weights[j];
+			for (uint32_t k = 0; k < 12; k++) {
+				m[k] += b[(k / 3) * 4 + (k % 3)] * w;
+			}
+		}
+
+		const Vector3 &v = p_vertices[i];
+		for (uint32_t k = 0; k < 3; k++) {
+			vertex[k] = m[k] * v.x + m[3 + k] * v.y + m[6 + k] * v.z + m[9 + k];
+		}
+		if (p_normals) {
+			const Vector3 &n = p_normals[i];
+			for (uint32_t k = 0; k < 3; k++) {
+				normal[k] = m[k] * n.x + m[3 + k] * n.y + m[6 + k] * n.z;
+			}
+		}
+		if (p_tangents) {
+			const Vector3 &t = p_tangents[i];
+			for (uint32_t k = 0; k < 3; k++) {
+				tangent[k] = m[k] * t.x + m[3 + k] * t.y + m[6 + k] * t.z;
+			}
+		}
+		_write_vertex(p_input, p_input.dst + (p_from + i) * p_input.dst_stride, vertex, p_normals ? normal : nullptr, p_tangents ? tangent : nullptr, p_tangents ? p_input.tangent_signs[p_from + i] : 1.0);
+	}
+}
+
+#if defined(SKINNING_SSE) || defined(SKINNING_NEON)
+static void _skin_block_simd(const SkinningKernels::DeformInput &p_input, uint32_t p_from, uint32_t p_count, const Vector3 *p_vertices, const Vector3 *p_normals, const Vector3 *p_tangents) {
+	float vertex[4];
+	float normal[4];
+	float tangent[4];
+	const bool position_only = !p_normals && !p_tangents;
+
+	for (uint32_t i = 0; i < p_count; i++) {
+		const Vector4i &bones = p_input.bone_indices[p_from + i];
+		const Vector4 &weights = p_input.bone_weights[p_from + i];
+
+		const float *b = p_input.palette + bones.x * SkinningKernels::PALETTE_FLOATS_PER_BONE;
+		simd4 w = SIMD_SPLAT(weights.x);
+		simd4 c0 = SIMD_MUL(SIMD_LOAD(b), w);
+		simd4 c1 = SIMD_MUL(SIMD_LOAD(b + 4), w);
+		simd4 c2 = SIMD_MUL(SIMD_LOAD(b + 8), w);
+		simd4 c3 = SIMD_MUL(SIMD_LOAD(b + 12), w);
+
+		b = p_input.palette + bones.y * SkinningKernels::PALETTE_FLOATS_PER_BONE;
+		w = SIMD_SPLAT(weights.y);
+		c0 = SIMD_MADD(c0, SIMD_LOAD(b), w);
+		c1 = SIMD_MADD(c1, SIMD_LOAD(b + 4), w);
+		c2 = SIMD_MADD(c2, SIMD_LOAD(b + 8), w);
+		c3 = SIMD_MADD(c3, SIMD_LOAD(b + 12), w);
+
+		b = p_input.palette + bones.z * SkinningKernels::PALETTE_FLOATS_PER_BONE;
+		w = SIMD_SPLAT(weights.z);
+		c0 = SIMD_MADD(c0, SIMD_LOAD(b), w);
+		c1 = SIMD_MADD(c1, SIMD_LOAD(b + 4), w);
+		c2 = SIMD_MADD(c2, SIMD_LOAD(b + 8), w);
+		c3 = SIMD_MADD(c3, SIMD_LOAD(b + 12), w);
+
+		b = p_input.palette + bones.w * SkinningKernels::PALETTE_FLOATS_PER_BONE;
+		w = SIMD_SPLAT(weights.w);
+		c0 = SIMD_MADD(c0, SIMD_LOAD(b), w);
+		c1 = SIMD_MADD(c1, SIMD_LOAD(b + 4), w);
+		c2 = SIMD_MADD(c2, SIMD_LOAD(b + 8), w);
+		c3 = SIMD_MADD(c3, SIMD_LOAD(b + 12), w);
+
+		const Vector3 &v = p_vertices[i];
+		simd4 r = SIMD_MADD(c3, c0, SIMD_SPLAT(v.x));
+		r = SIMD_MADD(r, c1, SIMD_SPLAT(v.y));
+		r = SIMD_MADD(r, c2, SIMD_SPLAT(v.z));
+		SIMD_STORE(vertex, r);
+
+		uint8_t *dst = p_input.dst + (p_from + i) * p_input.dst_stride;
+		if (position_only) {
+			memcpy(dst, vertex, sizeof(float) * 3);
+			continue;
+		}
+
+		if (p_normals) {
+			const Vector3 &n = p_normals[i];
+			r = SIMD_MUL(c0, SIMD_SPLAT(n.x));
+			r = SIMD_MADD(r, c1, SIMD_SPLAT(n.y));
+			r = SIMD_MADD(r, c2, SIMD_SPLAT(n.z));
+			SIMD_STORE(normal, r);
+		}
+		if (p_tangents) {
+			const Vector3 &t = p_tangents[i];
+			r = SIMD_MUL(c0, SIMD_SPLAT(t.x));
+			r = SIMD_MADD(r, c1, SIMD_SPLAT(t.y));
+			r = SIMD_MADD(r, c2, SIMD_SPLAT(t.z));
+			SIMD_STORE(tangent, r);
+		}
+		_write_vertex(p_input, dst, vertex, p_normals ? normal : nullptr, p_tangents ? tangent : nullptr, p_tangents ? p_input.tangent_signs[p_from + i] : 1.0);
+	}
+}
+#endif
+
+void SkinningKernels::deform(const DeformInput &p_input, uint32_t p_from, uint32_t p_to, bool p_use_simd) {
+	const bool use_blend_shapes = p_input.blend_shape_count > 0 && p_input.blend_weights;
+
+	Vector3 blend_vertices[BLOCK_SIZE];
+	Vector3 blend_normals[BLOCK_SIZE];
+	Vector3 blend_tangents[BLOCK_SIZE];
+
+	for (uint32_t from = p_from; from < p_to; from += BLOCK_SIZE) {
+		const uint32_t count = MIN(uint32_t(BLOCK_SIZE), p_to - from);
+
+		const Vector3 *vertices = p_input.vertices + from;
+		const Vector3 *normals = p_input.normals ? p_input.normals + from : nullptr;
+		const Vector3 *tangents = p_input.tangents ? p_input.tangents + from : nullptr;
+
+		if (use_blend_shapes) {
+			_blend_block(p_input, from, count, blend_vertices, normals ? blend_normals : nullptr, tangents ? blend_tangents : nullptr);
+			vertices = blend_vertices;
+			normals = normals ? blend_normals : nullptr;
+			tangents = tangents ? blend_tangents : nullptr;
+		}
+
+		if (!p_input.palette) {
+			_copy_block(p_input, from, count, vertices, normals, tangents);
+			continue;
+		}
+
+#if defined(SKINNING_SSE) || defined(SKINNING_NEON)
+		if (p_use_simd) {
+			_skin_block_simd(p_input, from, count, vertices, normals, tangents);
+			continue;
+		}
+#endif
+		_skin_block_scalar(p_input, from, count, vertices, normals, tangents);
+	}
+}
+
+bool SkinningKernels::has_simd() {
+#if defined(SKINNING_SSE) || defined(SKINNING_NEON)
+	return true;
+#else
+	return false;
+#endif
+}
+
+#endif // GLES3_ENABLED
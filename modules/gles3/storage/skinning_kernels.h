@@ -0,0 +1,72 @@
+/**
+ * skinning_kernels.h
+ *
+ * This file is part of Spike engine, a modification and extension of Godot.
+ *
+ */
+#pragma once
+
+#ifdef GLES3_ENABLED
+
+#include "core/math/vector3.h"
+#include "core/math/vector4.h"
+#include "core/math/vector4i.h"
+
+namespace OPENGL3 {
+
+// CPU kernels used by the software skinning path of MeshStorage.
+//
+// Bones are expected in the palette layout built by `build_palette`: every bone
+// is stored as 4 columns of 4 floats (basis x, basis y, basis z, origin, w = 0),
+// so blending the weighted bones and transforming a vertex only needs vertical
+// multiply-adds and maps directly onto SSE / NEON registers.
+class SkinningKernels {
+public:
+	enum {
+		PALETTE_FLOATS_PER_BONE = 16,
+		PALETTE_ALIGNMENT = 16, // Bytes, palettes are read with aligned SIMD loads.
+		BLOCK_SIZE = 64, // Vertices blended at once in the stack scratch of `deform`.
+	};
+
+	struct DeformInput {
+		uint32_t vertex_count = 0;
+
+		// Bind pose, `normals` and `tangents` are nullptr when the surface has none.
+		const Vector3 *vertices = nullptr;
+		const Vector3 *normals = nullptr;
+		const Vector3 *tangents = nullptr;
+		const float *tangent_signs = nullptr;
+
+		// Skinning, skipped when `palette` is nullptr. Aligned to PALETTE_ALIGNMENT.
+		const float *palette = nullptr;
+		const Vector4i *bone_indices = nullptr;
+		const Vector4 *bone_weights = nullptr;
+
+		// Blend shape targets, `blend_shape_count * vertex_count` entries each.
+		const Vector3 *blend_vertices = nullptr;
+		const Vector3 *blend_normals = nullptr;
+		const Vector3 *blend_tangents = nullptr;
+		const float *blend_weights = nullptr;
+		uint32_t blend_shape_count = 0;
+		bool blend_normalized = true;
+
+		// Interleaved vertex buffer layout, as uploaded to the GPU.
+		uint8_t *dst = nullptr;
+		uint32_t dst_stride = 0;
+		uint32_t normal_offset = 0;
+		uint32_t tangent_offset = 0;
+	};
+
+	// Converts `p_bone_count` bones from the 3x4 row major `es_skeleton_data` layout into the palette layout.
+	// `r_palette` must be aligned to PALETTE_ALIGNMENT.
+	static void build_palette(const float *p_skeleton_data, uint32_t p_bone_count, float *r_palette);
+
+	// Applies blend shapes then skinning to vertices [p_from, p_to) and writes position, normal and tangent into `dst`.
+	static void deform(const DeformInput &p_input, uint32_t p_from, uint32_t p_to, bool p_use_simd);
+
+	static bool has_simd();
+};
+
+} // namespace OPENGL3
+
+#endif // GLES3_ENABLED
@@ -252,12 +252,40 @@ String Utilities::get_captured_timestamp_name(uint32_t p_index) const {
 	return frames[frame].timestamp_result_names[p_index];
 }
 
+/* RENDER INFO */
+
+uint64_t Utilities::get_render_info(RenderInfo p_info) const {
+	ERR_FAIL_INDEX_V(p_info, RENDER_INFO_MAX, 0);
+	return render_info_result[p_info];
+}
+
+const char *Utilities::get_render_info_name(RenderInfo p_info) {
+	static const char *names[RENDER_INFO_MAX] = {
+		"skinning_instances_processed",
+		"skinning_instances_skipped",
+		"render_list_fill_usec",
+		"auto_instancing_draws",
+		"auto_instancing_elements",
+		"canvas_batches",
+		"canvas_batches_merged",
+	};
+	ERR_FAIL_INDEX_V(p_info, RENDER_INFO_MAX, "");
+	return names[p_info];
+}
+
+void Utilities::render_info_end_frame() {
+	for (int i = 0; i < RENDER_INFO_MAX; i++) {
+		render_info_result[i] = render_info[i];
+		render_info[i] = 0;
+	}
+}
+
 /* MISC */
 
 void Utilities::update_dirty_resources() {
 	GLES3::MaterialStorage::get_singleton()->_update_global_shader_uniforms();
 	GLES3::MaterialStorage::get_singleton()->_update_queued_materials();
-	//MeshStorage::get_singleton()->_update_dirty_skeletons();
+	MeshStorage::get_singleton()->_update_dirty_skeletons();
 	MeshStorage::get_singleton()->_update_dirty_multimeshes();
 	GLES3::TextureStorage::get_singleton()->update_texture_atlas();
 }
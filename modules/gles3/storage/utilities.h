@@ -84,6 +84,30 @@ public:
 	void _capture_timestamps_begin();
 	void capture_timestamps_end();
 
+	/* RENDER INFO */
+
+	// Counters specific to this renderer, they are not part of RS::RenderingInfo.
+	enum RenderInfo {
+		RENDER_INFO_SKINNING_INSTANCES_PROCESSED,
+		RENDER_INFO_SKINNING_INSTANCES_SKIPPED,
+		RENDER_INFO_RENDER_LIST_FILL_USEC,
+		RENDER_INFO_AUTO_INSTANCING_DRAWS,
+		RENDER_INFO_AUTO_INSTANCING_ELEMENTS,
+		RENDER_INFO_CANVAS_BATCHES,
+		RENDER_INFO_CANVAS_BATCHES_MERGED,
+		RENDER_INFO_MAX
+	};
+
+	uint64_t render_info[RENDER_INFO_MAX] = {}; // Accumulated during the current frame.
+	uint64_t render_info_result[RENDER_INFO_MAX] = {}; // Values of the last finished frame.
+
+	_FORCE_INLINE_ void render_info_add(RenderInfo p_info, uint64_t p_amount) {
+		render_info[p_info] += p_amount;
+	}
+	uint64_t get_render_info(RenderInfo p_info) const;
+	static const char *get_render_info_name(RenderInfo p_info);
+	void render_info_end_frame();
+
 	/* MISC */
 
 	virtual void update_dirty_resources() override;
@@ -83,6 +83,11 @@ int godot_lua_xpcall(lua_State *L, int n, int r);
  */
 extern int push_not_lua_method(lua_State *L, const char *p_method);
 
+/**
+ * @brief Pushes the closure calling `p_bind` on objects of `p_class`, or the replacement of `p_method` made from Lua
+ */
+extern void push_godot_method_bind(lua_State *L, const char *p_method, MethodBind *p_bind, const StringName &p_class);
+
 inline static bool check_hidden_key(const char *key) {
 	return key == nullptr || key[0] == '.' || (key[0] == '_' && key[1] == '_' && key[2] != '_');
 }
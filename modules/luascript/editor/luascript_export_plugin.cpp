@@ -6,42 +6,25 @@
 
 #include "luascript/luascript.h"
 
-static int spike_lua_Writer(lua_State *L, const void *p, size_t sz, void *u) {
-	Vector<uint8_t> *file = (Vector<uint8_t> *)u;
-	for (size_t i = 0; i < sz; i++) {
-		file->push_back(*((uint8_t *)p + i));
-	}
-	return 0;
-}
-
 void LuaScriptExportPlugin::_export_file(const String &p_path, const String &p_type, const Set<String> &p_features) {
 	if (!p_path.ends_with(".lua"))
 		return;
 
-	// TODO: check if export lua script as bytecode.
-	const Ref<EditorExportPreset> &preset = get_export_preset();
-	String script_key = preset.is_valid() ? preset->get_script_encryption_key() : String();
-	if (!IS_EMPTY(script_key)) {
-		Error error;
-		String code = FileAccess::get_file_as_string(p_path, &error);
-		if (error != OK) {
-			DLog("get_file_as_string NOT OK(%d): '%s'", error, p_path);
-			return;
-		}
+	Error error;
+	String code = FileAccess::get_file_as_string(p_path, &error);
+	if (error != OK) {
+		DLog("get_file_as_string NOT OK(%d): '%s'", error, p_path);
+		return;
+	}
 
-		auto L = LUA_STATE;
-		auto source_str = code.utf8();
-		GD_STR_HOLD(res_path, p_path);
-		int ret = luaL_loadbuffer(L, source_str.get_data(), source_str.length(), res_path);
-		if (ret != LUA_OK) {
-			DLog("luaL_loadbuffer NOT OK(%d): '%s'", error, p_path);
-			return;
+	// Debug exports keep line info for error messages and the debugger, and the source next to the bytecode.
+	// Release exports ship the bytecode alone, loaded through the remap of the source path.
+	bool strip = !p_features.has("debug");
+	Vector<uint8_t> bytecode;
+	if (LuaScriptLanguage::dump_bytecode(LUA_STATE, p_path, code.utf8(), strip, bytecode) == OK) {
+		add_file(p_path.get_basename() + ".luac", bytecode, strip);
+		if (strip) {
+			skip();
 		}
-
-		Vector<uint8_t> file;
-		lua_dump(L, spike_lua_Writer, &file, 0);
-		lua_pop(L, 1);
-
-		add_file(p_path.get_basename() + ".luac", file, true);
 	}
 }
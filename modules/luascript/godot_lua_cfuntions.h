@@ -14,6 +14,8 @@ int godot_lua_loader(lua_State *L);
 int godot_lua_seacher(lua_State *L);
 int godot_lua_push_error(lua_State *L);
 void godot_lua_hook(lua_State *L, lua_Debug *ar);
+int godot_lua_coroutine_create(lua_State *L);
+int godot_lua_coroutine_wrap(lua_State *L);
 int godot_global_indexer(lua_State *L);
 int godot_lua_topointer(lua_State *L);
 int godot_global_typeof(lua_State *L);
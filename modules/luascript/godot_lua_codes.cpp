@@ -60,33 +60,9 @@ static void load_global_chunk(lua_State *L, const char *libname, const char *lib
 	}
 }
 
-static void try_load_value_type(lua_State *L, const char *libname, const char *libsource, lua2godot_TypeConvert lua2godot, godot2lua_TypeConvert godot2lua) {
-	LuaScriptLanguage::add_lua2godot(StringName(libname), lua2godot);
-	LuaScriptLanguage::add_godot2lua(StringName(libname), godot2lua);
-
-	load_global_chunk(L, libname, libsource);
-}
-
-static int variant_utility_function_call(lua_State *L) {
-	const char *func_name = luaL_optstring(L, lua_upvalueindex(1), nullptr);
-	StringName p_name = StringName(func_name);
-	Variant ret;
-	LUA_TO_ARGS(p_args, argcount, 1);
-	CALL_ERROR error;
-	Variant::call_utility_function(p_name, &ret, p_args, argcount, error);
-	if (error.error != CALL_ERROR::CALL_OK) {
-		ELog("call_utility_function error: %d", error.error);
-	}
-	LuaScriptLanguage::push_variant(L, &ret);
-	return 1;
-}
-
 static int variant_utility_functions_indexer(lua_State *L) {
 	const char *func_name = lua_tostring(L, 2);
-	StringName p_name = StringName(func_name);
-	if (Variant::has_utility_function(p_name)) {
-		lua_pushstring(L, func_name); // t|k|n
-		lua_pushcclosure(L, &variant_utility_function_call, 1); // t|k|f
+	if (func_name && lua_push_utility_function(L, func_name)) { // t|k|f
 		lua_pushvalue(L, 2); // t|k|f|k
 		lua_pushvalue(L, -2); // t|k|f|k|f
 		lua_rawset(L, -5); // t|k|f
@@ -137,9 +113,13 @@ extern void load_thirdlib_serpent(lua_State *L) {
 }
 
 extern void load_godot_value_types(lua_State *L) {
-	try_load_value_type(L, "Vector2", code_vector2_lua, &convert_to_vector2, &lua_push_godot_vector2);
-	try_load_value_type(L, "Rect2", code_rect2_lua, &convert_to_rect2, &lua_push_godot_rect2);
-	try_load_value_type(L, "Vector3", code_vector3_lua, &convert_to_vector3, &lua_push_godot_vector3);
+	register_godot_value_types(L);
+	register_godot_value_converters();
+	register_godot_packed_arrays(L);
+	register_godot_packed_array_converters();
+	LuaScriptLanguage::add_godot2lua(StringName("Vector2"), &lua_push_godot_vector2);
+	LuaScriptLanguage::add_godot2lua(StringName("Rect2"), &lua_push_godot_rect2);
+	LuaScriptLanguage::add_godot2lua(StringName("Vector3"), &lua_push_godot_vector3);
 }
 
 #ifdef GODOT_3_X
@@ -315,10 +295,19 @@ static Variant godot_variant_call(lua_State *L, const char *method, int udata, i
 	arg_start = lua_absindex(L, arg_start);
 
 	Object *gd = nullptr;
-	if (luaL_getmetafield(L, udata, "__type")) {
-		// This is a full userdata: Variant
-		lua_pop(L, 1);
-		gdlua_tovariant(L, udata, var);
+	auto tag = lua_type(L, udata) == LUA_TUSERDATA ? LuaScriptLanguage::get_type_tag(L, udata) : LUA_TAG_NONE;
+	if (tag != LUA_TAG_NONE) {
+		// This is a full userdata: Variant, or one of the math value types
+		Variant value;
+		Variant *var = nullptr;
+		if (tag == LUA_TAG_VARIANT) {
+			// Call on the boxed Variant in place so that mutating methods stick
+			gdlua_tovariant(L, udata, boxed);
+			var = boxed;
+		} else {
+			value = LuaScriptLanguage::find_tag_converter(tag)(L, udata);
+			var = &value;
+		}
 		if (var != nullptr) {
 			if (var->get_type() != Variant::OBJECT) {
 				LUA_TO_ARGS(p_args, argcount, arg_start);
@@ -402,3 +391,36 @@ extern int push_not_lua_method(lua_State *L, const char *p_method) {
 	}
 	return 1;
 }
+
+/**
+ * @brief Native method resolved for one class, see `push_godot_method_bind`.
+ * Objects of that class which no other language scripts are called through the MethodBind,
+ * anything else (Variants, other classes the closure was handed to) goes by name as `godot_method_call` does.
+ */
+static int godot_method_bind_call(lua_State *L) {
+	Object *gd = lua_type(L, 1) == LUA_TTABLE ? lua_to_godot_object(L, 1) : nullptr;
+	if (gd && gd->get_class_name().data_unique_pointer() == lua_touserdata(L, lua_upvalueindex(3)) &&
+			(gd->get_script_instance() == nullptr || LuaScriptInstance::get_script_instance(gd))) {
+		auto bind = static_cast<MethodBind *>(lua_touserdata(L, lua_upvalueindex(2)));
+		LUA_TO_ARGS(p_args, argcount, 2);
+		CALL_ERROR error;
+		Variant ret = bind->call(gd, p_args, argcount, error);
+		LuaScriptLanguage::push_variant(L, &ret);
+		return 1;
+	}
+	return godot_method_call(L);
+}
+
+extern void push_godot_method_bind(lua_State *L, const char *p_method, MethodBind *p_bind, const StringName &p_class) {
+	// `connect` and friends are replaced by Lua functions for every class.
+	if (LuaScriptLanguage::push_godot_method(L, p_method)) {
+		if (lua_tocfunction(L, -1) != &godot_method_call) {
+			return;
+		}
+		lua_pop(L, 1);
+	}
+	lua_pushstring(L, p_method);
+	lua_pushlightuserdata(L, p_bind);
+	lua_pushlightuserdata(L, const_cast<void *>(p_class.data_unique_pointer()));
+	lua_pushcclosure(L, &godot_method_bind_call, 3);
+}
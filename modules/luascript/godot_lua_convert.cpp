@@ -3,6 +3,101 @@
  *
  */
 #include "godot_lua_convert_api.h"
+#include "core/io/marshalls.h"
+
+#ifdef PROTECT_CYCLE_REF
+struct LuaConvertingTable {
+	lua_State *L;
+	int index;
+	const void *table;
+};
+
+/**
+ * @brief Tables whose conversion is under way, from the outermost, with the state and the stack slot holding them.
+ * A table is only pushed once one of its keys or values is a table, the only way back to it: flat tables are never tracked.
+ * A Lua error longjmps over the guards and leaves their entries behind, see `LuaCycleGuard::is_ancestor`.
+ */
+static thread_local LocalVector<LuaConvertingTable> converting_tables;
+#endif
+
+/**
+ * @brief Tracks the table at `t` for the time of its conversion, from the first entry that could lead back to it
+ */
+class LuaCycleGuard {
+	lua_State *L;
+	int index;
+	const void *table;
+	uint32_t depth = 0;
+	bool tracked = false;
+
+#ifdef PROTECT_CYCLE_REF
+	/**
+	 * @brief Whether `p_entry` is a conversion still under way around this one: nested tables sit higher on the stack of the
+	 * same state, and a slot left by an interrupted conversion has been popped or reused since.
+	 */
+	_FORCE_INLINE_ bool is_ancestor(const LuaConvertingTable &p_entry) const {
+		return p_entry.L == L && p_entry.index < index && lua_topointer(L, p_entry.index) == p_entry.table;
+	}
+#endif
+
+public:
+	/**
+	 * @brief Returns true if the table is already being converted, further up the same conversion
+	 */
+	bool is_cycle() const {
+#ifdef PROTECT_CYCLE_REF
+		for (uint32_t i = 0; i < converting_tables.size(); i++) {
+			if (converting_tables[i].table == table && is_ancestor(converting_tables[i])) {
+				return true;
+			}
+		}
+#endif
+		return false;
+	}
+
+	/**
+	 * @brief Starts tracking the table if the key or the value of the current `lua_next` entry is a table
+	 */
+	_FORCE_INLINE_ void check_entry(lua_State *L) {
+#ifdef PROTECT_CYCLE_REF
+		if (!tracked && (lua_type(L, -1) == LUA_TTABLE || lua_type(L, -2) == LUA_TTABLE)) {
+			converting_tables.push_back({ L, index, table });
+			tracked = true;
+		}
+#endif
+	}
+
+	LuaCycleGuard(lua_State *p_state, int t) :
+			L(p_state),
+			index(t),
+			table(lua_topointer(p_state, t)) {
+#ifdef PROTECT_CYCLE_REF
+		// Entries left by interrupted conversions are dropped from the top, this guard truncates back to its depth.
+		depth = converting_tables.size();
+		while (depth > 0 && !is_ancestor(converting_tables[depth - 1])) {
+			depth--;
+		}
+		if (depth < converting_tables.size()) {
+			converting_tables.resize(depth);
+		}
+#endif
+	}
+
+	~LuaCycleGuard() {
+#ifdef PROTECT_CYCLE_REF
+		if (tracked) {
+			converting_tables.resize(depth);
+		}
+#endif
+	}
+};
+
+// Functions, threads and tables met again while being converted are replaced by their name, "table: 0x...".
+static Variant tostring_to_variant(lua_State *L, int pos) {
+	Variant ret = String::utf8(luaL_tolstring(L, pos, nullptr));
+	lua_pop(L, 1);
+	return ret;
+}
 
 Object *lua_to_godot_object(lua_State *L, int pos, bool *valid) {
 	void *udata = nullptr;
@@ -50,6 +145,9 @@ Variant lua_to_godot_variant(lua_State *L, int pos) {
 		case LUA_TSTRING:
 			return Variant(String::utf8(lua_tostring(L, pos)));
 		case LUA_TTABLE: {
+			if (LuaScriptLanguage::get_type_tag(L, pos) == LUA_TAG_OBJECT) {
+				return lua_tagged_object_to_variant(L, pos);
+			}
 			if (luaL_getmetafield(L, pos, "__name")) {
 				auto class_name = lua_tostring(L, -1);
 				lua_pop(L, 1);
@@ -97,40 +195,45 @@ Variant lua_to_godot_variant(lua_State *L, int pos) {
 				return Variant(obj);
 			break;
 		}
-		case LUA_TUSERDATA:
-			if (luaL_getmetafield(L, pos, "__type") == LUA_TNIL) {
-				if (luaL_getmetafield(L, pos, "__name") != LUA_TNIL) {
-					auto type_name = lua_tostring(L, -1);
-					lua_pop(L, 1);
-					auto conv = LuaScriptLanguage::find_udata2var(type_name);
-					if (conv != nullptr) {
-						return conv(lua_touserdata(L, pos));
-					}
-				}
-			} else {
+		case LUA_TUSERDATA: {
+			auto tag = LuaScriptLanguage::get_type_tag(L, pos);
+			if (tag != LUA_TAG_NONE) {
+				auto converter = LuaScriptLanguage::find_tag_converter(tag);
+				return converter ? converter(L, pos) : Variant();
+			}
+			if (luaL_getmetafield(L, pos, "__name") != LUA_TNIL) {
+				auto type_name = lua_tostring(L, -1);
 				lua_pop(L, 1);
-				gdlua_tovariant(L, pos, var);
-				if (var != nullptr)
-					return *var;
-				break;
+				auto conv = LuaScriptLanguage::find_udata2var(type_name);
+				if (conv != nullptr) {
+					return conv(lua_touserdata(L, pos));
+				}
 			}
+		}
 		case LUA_TNIL:
 			return Variant();
 		default:
-			const char *str = luaL_tolstring(L, -1, nullptr);
-			lua_pop(L, 1);
-			return Variant(str);
+			return tostring_to_variant(L, pos);
 	}
 	return Variant();
 }
 
+Variant lua_tagged_object_to_variant(lua_State *L, int pos) {
+	return Variant(lua_to_godot_object(L, pos));
+}
+
+Variant lua_tagged_variant_to_variant(lua_State *L, int pos) {
+	gdlua_tovariant(L, pos, var);
+	return var ? *var : Variant();
+}
+
 Variant lua_to_godot_array(lua_State *L, int t) {
 	Array array;
 	if (lua_istable(L, t)) {
 		t = lua_absindex(L, t);
-		const char *ret = _begin_cycle_check(L, t);
-		if (ret != nullptr) {
-			return Variant(ret);
+		LuaCycleGuard guard(L, t);
+		if (guard.is_cycle()) {
+			return tostring_to_variant(L, t);
 		}
 
 		int i = 0;
@@ -138,12 +241,11 @@ Variant lua_to_godot_array(lua_State *L, int t) {
 		while (lua_next(L, t) != 0) {
 			i += 1;
 			if (lua_isinteger(L, -2) && lua_tointeger(L, -2) == i) {
+				guard.check_entry(L);
 				array.append(lua_to_godot_variant(L, -1));
 			}
 			lua_pop(L, 1);
 		}
-
-		_end_cycle_check(L, t);
 	}
 	return Variant(array);
 }
@@ -152,9 +254,9 @@ Vector<Variant> lua_to_godot_variant_vector(lua_State *L, int t) {
 	Vector<Variant> array;
 	if (lua_istable(L, t)) {
 		t = lua_absindex(L, t);
-		const char *ret = _begin_cycle_check(L, t);
-		if (ret != nullptr) {
-			return Variant(ret);
+		LuaCycleGuard guard(L, t);
+		if (guard.is_cycle()) {
+			return tostring_to_variant(L, t);
 		}
 
 		int i = 0;
@@ -162,12 +264,11 @@ Vector<Variant> lua_to_godot_variant_vector(lua_State *L, int t) {
 		while (lua_next(L, t) != 0) {
 			i += 1;
 			if (lua_isinteger(L, -2) && lua_tointeger(L, -2) == i) {
+				guard.check_entry(L);
 				array.push_back(lua_to_godot_variant(L, -1));
 			}
 			lua_pop(L, 1);
 		}
-
-		_end_cycle_check(L, t);
 	}
 	return array;
 }
@@ -176,23 +277,17 @@ Variant lua_to_godot_dictionary(lua_State *L, int t) {
 	Dictionary dict;
 	if (lua_istable(L, t)) {
 		t = lua_absindex(L, t);
-		const char *ret = _begin_cycle_check(L, t);
-		if (ret != nullptr) {
-			return Variant(ret);
+		LuaCycleGuard guard(L, t);
+		if (guard.is_cycle()) {
+			return tostring_to_variant(L, t);
 		}
 
 		lua_pushnil(L);
 		while (lua_next(L, t) != 0) {
-			auto key = lua_to_godot_variant(L, -2);
-			if (key != Variant(TABLE_2_CONTAINER_FLAG)) {
-				auto value = lua_to_godot_variant(L, -1);
-				dict[key] = value;
-			}
-
+			guard.check_entry(L);
+			dict[lua_to_godot_variant(L, -2)] = lua_to_godot_variant(L, -1);
 			lua_pop(L, 1);
 		}
-
-		_end_cycle_check(L, t);
 	}
 	return Variant(dict);
 }
@@ -216,17 +311,123 @@ void lua_push_godot_array(lua_State *L, const Array &a) {
 	}
 }
 
+static bool is_typed_dictionary_key(const Variant &p_key) {
+	switch (p_key.get_type()) {
+		case Variant::NIL:
+			return false;
+		case TYPE_REAL:
+			return !Math::is_nan(double(p_key));
+		default:
+			return true;
+	}
+}
+
+/**
+ * @brief Addresses are the registry keys of the table holding the userdata used as key for each value, by the encoded value,
+ * and of the metatable of the dictionaries pushed with typed keys
+ */
+static char value_keys_key = 0;
+static char typed_dictionary_meta_key = 0;
+
+// Math types, compared by value: Vector2 up to Color in both enums. NodePath and RID are left out.
+_FORCE_INLINE_ static bool is_value_dictionary_key(Variant::Type p_type) {
+	return p_type >= Variant::VECTOR2 && p_type <= Variant::COLOR;
+}
+
+/**
+ * @brief Pushes the userdata standing for `p_key` in dictionaries, the same one for equal values while it is in use
+ */
+static void push_value_dictionary_key(lua_State *L, const Variant &p_key) {
+	uint8_t buffer[256];
+	int len = 0;
+	encode_variant(p_key, nullptr, len);
+	if (unlikely(len > int(sizeof(buffer)))) {
+		LuaScriptLanguage::push_variant(L, &p_key);
+		ERR_FAIL_MSG("Dictionary key too large to be compared by value.");
+	}
+	encode_variant(p_key, buffer, len);
+
+	if (lua_rawgetp(L, LUA_REGISTRYINDEX, &value_keys_key) != LUA_TTABLE) { // keys?
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_createtable(L, 0, 1);
+		luatable_rawset(L, -1, "__mode", "v");
+		lua_setmetatable(L, -2);
+		lua_pushvalue(L, -1);
+		lua_rawsetp(L, LUA_REGISTRYINDEX, &value_keys_key);
+	}
+	lua_pushlstring(L, (const char *)buffer, len); // keys, bytes
+	lua_pushvalue(L, -1);
+	if (lua_rawget(L, -3) == LUA_TNIL) { // keys, bytes, key?
+		lua_pop(L, 1);
+		LuaScriptLanguage::push_variant(L, &p_key);
+		lua_pushvalue(L, -1);
+		lua_insert(L, -3); // keys, key, bytes, key
+		lua_rawset(L, -4);
+	} else {
+		lua_remove(L, -2);
+	}
+	lua_remove(L, -2); // key
+}
+
+/**
+ * @brief Replaces a math value key at `p_pos` with the userdata the dictionary holds for its value
+ */
+static bool to_value_dictionary_key(lua_State *L, int p_pos) {
+	int type = lua_type(L, p_pos);
+	if ((type != LUA_TUSERDATA && type != LUA_TTABLE) || !lua_getmetatable(L, p_pos)) {
+		return false;
+	}
+	lua_pop(L, 1);
+	Variant key = lua_to_godot_variant(L, p_pos);
+	if (!is_value_dictionary_key(key.get_type())) {
+		return false;
+	}
+	push_value_dictionary_key(L, key);
+	lua_replace(L, p_pos);
+	return true;
+}
+
+// A fresh `Vector2i(1, 2)` is never a raw key of the table, lookups and new keys come here.
+static int typed_dictionary_index(lua_State *L) {
+	if (!to_value_dictionary_key(L, 2)) {
+		return 0;
+	}
+	lua_rawget(L, 1);
+	return 1;
+}
+
+static int typed_dictionary_newindex(lua_State *L) {
+	to_value_dictionary_key(L, 2);
+	lua_settop(L, 3);
+	lua_rawset(L, 1);
+	return 0;
+}
+
 void lua_push_godot_dictionary(lua_State *L, const Dictionary &d) {
-	List<Variant> keys;
-	d.get_key_list(&keys);
-
-	lua_createtable(L, 0, keys.size());
-	for (List<Variant>::Element *E = keys.front(); E; E = E->next()) {
-		auto k = E->get();
-		auto v = d[k];
-		lua_pushstring(L, GD_UTF8_STR(k.operator String()));
-		LuaScriptLanguage::push_variant(L, &v);
-		lua_settable(L, -3);
+	bool typed_keys = LuaScriptLanguage::has_typed_dictionary_keys();
+	lua_createtable(L, 0, d.size());
+	if (typed_keys) {
+		if (lua_rawgetp(L, LUA_REGISTRYINDEX, &typed_dictionary_meta_key) != LUA_TTABLE) { // dict, meta?
+			lua_pop(L, 1);
+			lua_createtable(L, 0, 2);
+			luatable_rawset(L, -1, "__index", &typed_dictionary_index);
+			luatable_rawset(L, -1, "__newindex", &typed_dictionary_newindex);
+			lua_pushvalue(L, -1);
+			lua_rawsetp(L, LUA_REGISTRYINDEX, &typed_dictionary_meta_key);
+		}
+		lua_setmetatable(L, -2);
+	}
+	for (const Variant *k = d.next(nullptr); k; k = d.next(k)) {
+		if (typed_keys && is_value_dictionary_key(k->get_type())) {
+			push_value_dictionary_key(L, *k);
+		} else if (typed_keys && is_typed_dictionary_key(*k)) {
+			LuaScriptLanguage::push_variant(L, k);
+		} else {
+			lua_pushstring(L, GD_UTF8_STR(k->operator String()));
+		}
+		LuaScriptLanguage::push_variant(L, &d[*k]);
+		lua_rawset(L, -3);
 	}
 }
 
@@ -11,7 +11,6 @@
 #include "luascript_language.h"
 
 #define PROTECT_CYCLE_REF
-#define TABLE_2_CONTAINER_FLAG LuaScriptLanguage::get_object()
 
 #define TO_USERDATA(T, i) static_cast<T *>(lua_touserdata(L, i))
 
@@ -26,33 +25,25 @@
 		DLog("godot_call: %s.%s(%s) => %s", self, method, args_str, ret); \
 	} while (0)
 
-inline static const char *_begin_cycle_check(lua_State *L, int t) {
-#ifdef PROTECT_CYCLE_REF
-	lua_rawgetp(L, t, TABLE_2_CONTAINER_FLAG);
-	if (!lua_isnil(L, -1)) {
-		const char *cycle = luaL_tolstring(L, -1, nullptr);
-		lua_pop(L, 2);
-		return cycle;
-	}
-	lua_pop(L, 1);
-
-	lua_pushvalue(L, t);
-	lua_rawsetp(L, t, TABLE_2_CONTAINER_FLAG);
-#endif
-	return nullptr;
-}
-
-inline static void _end_cycle_check(lua_State *L, int t) {
-#ifdef PROTECT_CYCLE_REF
-	lua_pushnil(L);
-	lua_rawsetp(L, t, TABLE_2_CONTAINER_FLAG);
-#endif
-}
-
 Object *lua_to_godot_object(lua_State *L, int pos, bool *valid = nullptr);
 
 Variant lua_to_godot_variant(lua_State *L, int pos);
 
+Variant lua_tagged_object_to_variant(lua_State *L, int pos);
+
+Variant lua_tagged_variant_to_variant(lua_State *L, int pos);
+
+/**
+ * @brief Pushes a closure calling the utility function `p_name` through its validated pointer, false if there is none
+ */
+bool lua_push_utility_function(lua_State *L, const char *p_name);
+
+/**
+ * @brief Pushes a closure calling the builtin method `p_name` of `p_type` through its validated pointer, false if there is none.
+ * The closure takes the Variant userdata as first argument.
+ */
+bool lua_push_builtin_method(lua_State *L, Variant::Type p_type, const char *p_name);
+
 Variant lua_to_godot_array(lua_State *L, int t);
 
 Vector<Variant> lua_to_godot_variant_vector(lua_State *L, int t);
@@ -65,4 +56,11 @@ bool lua_check_godot_variant(lua_State *L, int pos, Variant::Type type, Variant
 
 void lua_push_godot_array(lua_State *L, const Array &a);
 
+/**
+ * @brief Keys are converted to strings, unless `luascript/dictionary/typed_keys` is set: then they are pushed as Lua
+ * integers, booleans, strings or values (value types, objects) and come back with their type. Nil and NaN keys, which
+ * Lua tables cannot hold, are still stringified, and a float key holding an integer comes back as an int.
+ * Math value keys (Vector2, Vector2i, Color, ...) are compared by value: equal keys share one userdata, and the table's
+ * metatable maps a fresh `t[Vector2i(1, 2)]` to it. Mutating a key taken from `pairs` breaks the lookups of its entry.
+ */
 void lua_push_godot_dictionary(lua_State *L, const Dictionary &d);
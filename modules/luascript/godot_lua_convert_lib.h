@@ -6,37 +6,20 @@
 #pragma once
 
 #include "godot_lua_table_api.h"
+#include "godot_lua_packed_arrays.h"
 #include "lib/lua/lua.hpp"
 #include "luascript.h"
 
 _FORCE_INLINE_ void lua_push_godot_vector2(lua_State *L, const Variant &var) {
-	auto v = var.operator Vector2();
-	lua_createtable(L, 0, 2);
-	luatable_rawset(L, -1, "x", v.x);
-	luatable_rawset(L, -1, "y", v.y);
-	lua_getglobal(L, "Vector2");
-	gdlua_setmetatable(L, -2);
+	lua_push_godot_value(L, var.operator Vector2());
 }
 
 _FORCE_INLINE_ void lua_push_godot_rect2(lua_State *L, const Variant &var) {
-	auto v = var.operator Rect2();
-	lua_createtable(L, 0, 2);
-	lua_push_godot_vector2(L, v.position);
-	lua_setfield(L, -2, "position");
-	lua_push_godot_vector2(L, v.size);
-	lua_setfield(L, -2, "size");
-	lua_getglobal(L, "Rect2");
-	gdlua_setmetatable(L, -2);
+	lua_push_godot_value(L, var.operator Rect2());
 }
 
 _FORCE_INLINE_ void lua_push_godot_vector3(lua_State *L, const Variant &var) {
-	auto v = var.operator Vector3();
-	lua_createtable(L, 0, 3);
-	luatable_rawset(L, -1, "x", v.x);
-	luatable_rawset(L, -1, "y", v.y);
-	luatable_rawset(L, -1, "z", v.z);
-	lua_getglobal(L, "Vector3");
-	gdlua_setmetatable(L, -2);
+	lua_push_godot_value(L, var.operator Vector3());
 }
 
 _FORCE_INLINE_ void lua_push_godot_transform2d(lua_State *L, const Transform2D &v) {
@@ -115,33 +98,3 @@ _FORCE_INLINE_ void lua_push_godot_color(lua_State *L, const Color &v) {
 	lua_getglobal(L, "Color");
 	gdlua_setmetatable(L, -2);
 }
-
-_FORCE_INLINE_ Variant convert_to_vector2(lua_State *L, int pos) {
-	lua_Number x, y;
-	luatable_get(L, pos, "x", x);
-	luatable_get(L, pos, "y", y);
-	return Variant(Vector2(x, y));
-}
-
-_FORCE_INLINE_ Variant convert_to_rect2(lua_State *L, int pos) {
-	lua_Number x, y, w, h;
-	lua_getfield(L, pos, "position");
-	luatable_get(L, -1, "x", x);
-	luatable_get(L, -1, "y", y);
-	lua_pop(L, 1);
-
-	lua_getfield(L, pos, "size");
-	luatable_get(L, -1, "x", w);
-	luatable_get(L, -1, "y", h);
-	lua_pop(L, 1);
-
-	return Variant(Rect2(x, y, w, h));
-}
-
-_FORCE_INLINE_ Variant convert_to_vector3(lua_State *L, int pos) {
-	lua_Number x, y, z;
-	luatable_get(L, pos, "x", x);
-	luatable_get(L, pos, "y", y);
-	luatable_get(L, pos, "z", z);
-	return Variant(Vector3(x, y, z));
-}
\ No newline at end of file
@@ -133,7 +133,35 @@ int godot_lua_push_error(lua_State *L) {
 	return 0;
 }
 
+// `coroutine.create` and `coroutine.wrap`, the original as upvalue, tracking the coroutines for the hook.
+int godot_lua_coroutine_create(lua_State *L) {
+	lua_pushvalue(L, lua_upvalueindex(1));
+	lua_insert(L, 1);
+	lua_call(L, lua_gettop(L) - 1, 1);
+	LuaScriptLanguage::track_coroutine(L, -1);
+	return 1;
+}
+
+int godot_lua_coroutine_wrap(lua_State *L) {
+	lua_pushvalue(L, lua_upvalueindex(1));
+	lua_insert(L, 1);
+	lua_call(L, lua_gettop(L) - 1, 1);
+	// The function returned by `coroutine.wrap` holds its coroutine as first upvalue.
+	if (lua_getupvalue(L, -1, 1)) {
+		LuaScriptLanguage::track_coroutine(L, -1);
+		lua_pop(L, 1);
+	}
+	return 1;
+}
+
 void godot_lua_hook(lua_State *L, lua_Debug *ar) {
+	if (LuaScriptLanguage::is_profiling() && ar->event != LUA_HOOKLINE) {
+		LuaScriptLanguage::profile_hook(L, ar);
+	}
+	if (!LuaScriptLanguage::is_debugging()) {
+		return;
+	}
+
 #ifdef GODOT_3_X
 	auto dbg = ScriptDebugger::get_singleton();
 #else
@@ -151,22 +179,14 @@ void godot_lua_hook(lua_State *L, lua_Debug *ar) {
 			}
 		}
 
-		auto *bps = dbg->get_breakpoints().getptr(ar->currentline);
-		if (do_break || bps) {
+		if (do_break || LuaScriptLanguage::is_breakpoint(L, ar)) {
 			lua_getinfo(L, "Slnt", ar);
-			if (!do_break) {
-				StringName source = ar->source;
-				if (bps->find(source)) {
-					do_break = true;
-				}
-			}
-		}
-
-		if (do_break) {
 			LuaScriptLanguage::breakpoint(L);
 			LuaScriptLanguage::trackback(ar->source, ar->currentline, ar->name);
 			LuaScriptLanguage::record_stack_info(L, 1, ar);
 			dbg->debug(LuaScriptLanguage::get_singleton());
+			// Stepping needs the full hook, continuing only the line hook if any breakpoint is left.
+			LuaScriptLanguage::update_debug_hook();
 		}
 	} else if (ar->event == LUA_HOOKCALL) {
 		if (dbg->get_lines_left() > 0 && dbg->get_depth() >= 0) {
@@ -89,6 +89,125 @@ static bool push_from_metatable(lua_State *L, const StringName &class_name, cons
 	return found;
 }
 
+/**
+ * @brief Getter of a native property in the member table of a class
+ */
+struct LuaPropertyGetter {
+	MethodBind *getter;
+	int index;
+};
+
+/**
+ * @brief Address is the registry key of the member tables, by the unique pointer of the class name
+ */
+static char member_tables_key = 0;
+
+/**
+ * @brief Resolves the members of `class_name` once: methods (closures from `push_godot_method_bind`) and properties (`LuaPropertyGetter` userdata).
+ * Signals and properties without getter are `true`, only `Object::get` knows about them.
+ * Names with a value in the metatables are left out, so `lua_godot_object_indexer` reads them live and patched class tables are honored.
+ * The table is left on the stack.
+ */
+void build_godot_member_table(lua_State *L, int metatable, const StringName &class_name) {
+	metatable = lua_absindex(L, metatable);
+	lua_newtable(L); // members
+	int members = lua_gettop(L);
+
+	List<PropertyInfo> properties;
+	ClassDB::get_property_list(class_name, &properties);
+	for (const List<PropertyInfo>::Element *E = properties.front(); E; E = E->next()) {
+		const PropertyInfo &info = E->get();
+#ifdef GODOT_3_X
+		if (info.usage & (PROPERTY_USAGE_GROUP | PROPERTY_USAGE_CATEGORY)) {
+#else
+		if (info.usage & (PROPERTY_USAGE_GROUP | PROPERTY_USAGE_SUBGROUP | PROPERTY_USAGE_CATEGORY)) {
+#endif
+			continue;
+		}
+		GD_STR_HOLD(name, info.name);
+		lua_pushstring(L, name);
+		MethodBind *getter = ClassDB::get_method(class_name, ClassDB::get_property_getter(class_name, info.name));
+		if (getter) {
+			auto accessor = static_cast<LuaPropertyGetter *>(lua_newuserdatauv(L, sizeof(LuaPropertyGetter), 0));
+			accessor->getter = getter;
+			accessor->index = ClassDB::get_property_index(class_name, info.name);
+		} else {
+			lua_pushboolean(L, true);
+		}
+		lua_rawset(L, members);
+	}
+
+	List<MethodInfo> signals;
+	ClassDB::get_signal_list(class_name, &signals);
+	for (const List<MethodInfo>::Element *E = signals.front(); E; E = E->next()) {
+		GD_STR_HOLD(name, E->get().name);
+		lua_pushboolean(L, true);
+		lua_setfield(L, members, name);
+	}
+
+	List<MethodInfo> methods;
+	ClassDB::get_method_list(class_name, &methods);
+	for (const List<MethodInfo>::Element *E = methods.front(); E; E = E->next()) {
+		// Virtual methods have no bind, scripts implement them.
+		MethodBind *bind = ClassDB::get_method(class_name, E->get().name);
+		if (bind) {
+			GD_STR_HOLD(name, E->get().name);
+			push_godot_method_bind(L, name, bind, class_name);
+			lua_setfield(L, members, name);
+		}
+	}
+
+	// Values in the metatables, from the class up to `Object`, win over methods and properties.
+	lua_pushvalue(L, metatable);
+	do {
+		lua_pushnil(L);
+		while (lua_next(L, -2)) {
+			lua_pop(L, 1);
+			if (lua_type(L, -1) == LUA_TSTRING) {
+				lua_pushvalue(L, -1);
+				lua_pushnil(L);
+				lua_rawset(L, members);
+			}
+		}
+	} while (lua_getmetatable(L, -1));
+	lua_settop(L, members);
+
+	if (lua_rawgetp(L, LUA_REGISTRYINDEX, &member_tables_key) != LUA_TTABLE) { // members|tables?
+		lua_pop(L, 1);
+		lua_newtable(L);
+		lua_pushvalue(L, -1);
+		lua_rawsetp(L, LUA_REGISTRYINDEX, &member_tables_key);
+	}
+	lua_pushvalue(L, members);
+	lua_rawsetp(L, -2, class_name.data_unique_pointer());
+	lua_pop(L, 1); // members
+}
+
+/**
+ * @brief Drops the member tables, they are built again on the next lookup. Needed when a name gets a value in a class table.
+ */
+void reset_godot_member_tables(lua_State *L) {
+	lua_pushnil(L);
+	lua_rawsetp(L, LUA_REGISTRYINDEX, &member_tables_key);
+}
+
+static void push_member_table(lua_State *L, const StringName &class_name) {
+	int top = lua_gettop(L);
+	if (lua_rawgetp(L, LUA_REGISTRYINDEX, &member_tables_key) == LUA_TTABLE &&
+			lua_rawgetp(L, -1, class_name.data_unique_pointer()) == LUA_TTABLE) { // tables|members
+		lua_remove(L, -2);
+		return;
+	}
+	lua_settop(L, top);
+
+	// Registering the class builds its table, the ones dropped by `reset_godot_member_tables` are built here.
+	if (!LuaScriptLanguage::import_godot_object(L, class_name)) {
+		lua_newtable(L);
+	}
+	build_godot_member_table(L, -1, class_name); // mt|members
+	lua_remove(L, -2);
+}
+
 /**
  * @brief Meta method `__index` for Godot Object
  */
@@ -104,19 +223,59 @@ int lua_godot_object_indexer(lua_State *L) {
 		}
 
 		auto instance = LuaScriptInstance::get_script_instance(gd);
-		if (instance && instance->push_member(L, key)) {
+		if (instance && instance->push_member(L, method)) {
 			return 1;
 		}
 
-		if (push_from_metatable(L, class_name, key))
-			return 1;
+		// Script methods of other languages are not in the member tables.
+		bool native_only = instance || gd->get_script_instance() == nullptr;
+		bool skip_methods = false;
+		push_member_table(L, class_name); // t|k|members
+		lua_pushvalue(L, 2);
+		switch (lua_rawget(L, -2)) { // t|k|members|member
+			case LUA_TNIL:
+				lua_pop(L, 2);
+				break;
+			case LUA_TUSERDATA: {
+				auto property = static_cast<const LuaPropertyGetter *>(lua_touserdata(L, -1));
+				lua_pop(L, 2);
+				if (native_only) {
+					CALL_ERROR error;
+					Variant value;
+					if (property->index >= 0) {
+						Variant index = property->index;
+						const Variant *args[1] = { &index };
+						value = property->getter->call(gd, args, 1, error);
+					} else {
+						value = property->getter->call(gd, nullptr, 0, error);
+					}
+					if (error.error == CALL_ERROR::CALL_OK) {
+						LuaScriptLanguage::push_variant(L, &value);
+						return 1;
+					}
+				}
+				skip_methods = native_only;
+			} break;
+			case LUA_TBOOLEAN:
+				lua_pop(L, 2);
+				skip_methods = native_only;
+				break;
+			default:
+				lua_remove(L, -2);
+				return 1;
+		}
 
-		if (auto script = Object::cast_to<Script>(gd))
-			if (script->has_method(method))
-				return push_not_lua_method(L, key);
+		if (!skip_methods) {
+			if (push_from_metatable(L, class_name, key))
+				return 1;
 
-		if (gd->has_method(method))
-			return push_not_lua_method(L, key);
+			if (auto script = Object::cast_to<Script>(gd))
+				if (script->has_method(method))
+					return push_not_lua_method(L, key);
+
+			if (gd->has_method(method))
+				return push_not_lua_method(L, key);
+		}
 
 		bool valid;
 		Variant value = gd->get(method, &valid);
@@ -190,7 +349,22 @@ int lua_godot_object_newindexer(lua_State *L) {
 				lua_rawset(L, -3);
 				lua_pop(L, 1);
 			}
+		} else if (auto script = Object::cast_to<LuaScript>(gd)) {
+			script->push_self(L);
+			bool is_script_table = lua_rawequal(L, 1, -1);
+			lua_pop(L, 1);
+			if (!valid && is_script_table) {
+				// A field added to the script table at runtime, e.g. `MyScript.update = fn`: cached misses are stale.
+				lua_settop(L, 3);
+				lua_rawset(L, 1);
+				LuaScriptLanguage::invalidate_member_caches();
+			}
 		}
+	} else if (luatable_has(L, 1, META_NATIVE_FIELD)) {
+		// A class table being patched, e.g. `Node.get_name = wrapper`: the name now shadows the native member.
+		lua_settop(L, 3);
+		lua_rawset(L, 1);
+		reset_godot_member_tables(L);
 	} else {
 		const char *key = lua_tostring(L, 2);
 		WARN_PRINT(vformat("try to set value for key `%s` on null instance.", key));
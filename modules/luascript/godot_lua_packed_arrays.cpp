@@ -0,0 +1,320 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ *
+ */
+
+#include "godot_lua_packed_arrays.h"
+#include "godot_lua_convert_api.h"
+
+#ifndef GODOT_3_X
+template <class T>
+_FORCE_INLINE_ static T to_element(lua_State *L, int pos) {
+	if (T *v = lua_to_godot_value_ptr<T>(L, pos)) {
+		return *v;
+	}
+	return lua_to_godot_variant(L, pos);
+}
+
+Vector2 LuaPackedArrayType<Vector2>::check(lua_State *L, int pos) {
+	return to_element<Vector2>(L, pos);
+}
+
+Vector3 LuaPackedArrayType<Vector3>::check(lua_State *L, int pos) {
+	return to_element<Vector3>(L, pos);
+}
+
+template <class T>
+_FORCE_INLINE_ static Vector<T> *check_packed_array(lua_State *L, int pos) {
+	return &static_cast<LuaPackedArray<T> *>(luaL_checkudata(L, pos, LuaPackedArrayType<T>::get_name()))->array;
+}
+
+// Indices start at 0 as in Godot, negative ones count from the end.
+static int64_t check_index(lua_State *L, int pos, int64_t p_size) {
+	int64_t index = luaL_checkinteger(L, pos);
+	if (index < 0) {
+		index += p_size;
+	}
+	luaL_argcheck(L, index >= 0 && index < p_size, pos, "index out of bounds");
+	return index;
+}
+
+template <class T>
+static int packed_get(lua_State *L) {
+	Vector<T> *array = check_packed_array<T>(L, 1);
+	int64_t index = check_index(L, 2, array->size());
+	LuaPackedArrayType<T>::push(L, array->ptr()[index]);
+	return 1;
+}
+
+template <class T>
+static int packed_set(lua_State *L) {
+	Vector<T> *array = check_packed_array<T>(L, 1);
+	int64_t index = check_index(L, 2, array->size());
+	T value = LuaPackedArrayType<T>::check(L, 3);
+	array->ptrw()[index] = value;
+	return 0;
+}
+
+template <class T>
+static int packed_size(lua_State *L) {
+	lua_pushinteger(L, check_packed_array<T>(L, 1)->size());
+	return 1;
+}
+
+template <class T>
+static int packed_is_empty(lua_State *L) {
+	lua_pushboolean(L, check_packed_array<T>(L, 1)->is_empty());
+	return 1;
+}
+
+template <class T>
+static int packed_resize(lua_State *L) {
+	Vector<T> *array = check_packed_array<T>(L, 1);
+	int64_t size = luaL_checkinteger(L, 2);
+	luaL_argcheck(L, size >= 0, 2, "negative size");
+	int64_t old_size = array->size();
+	array->resize(size);
+	if (size > old_size) {
+		memset(array->ptrw() + old_size, 0, (size - old_size) * sizeof(T));
+	}
+	return 0;
+}
+
+template <class T>
+static int packed_push_back(lua_State *L) {
+	check_packed_array<T>(L, 1)->push_back(LuaPackedArrayType<T>::check(L, 2));
+	return 0;
+}
+
+template <class T>
+static int packed_fill(lua_State *L) {
+	check_packed_array<T>(L, 1)->fill(LuaPackedArrayType<T>::check(L, 2));
+	return 0;
+}
+
+template <class T>
+static int packed_slice(lua_State *L) {
+	Vector<T> *array = check_packed_array<T>(L, 1);
+	lua_push_godot_packed_array(L, array->slice(luaL_optinteger(L, 2, 0), luaL_optinteger(L, 3, INT_MAX)));
+	return 1;
+}
+
+/**
+ * @brief `array:copy_from(source, to, from, count)` copies `count` elements of `source` starting at `from` into the array at `to`,
+ * growing it if needed. `source` is a packed array of the same type or a Lua sequence, `count` defaults to the rest of `source`.
+ */
+template <class T>
+static int packed_copy_from(lua_State *L) {
+	Vector<T> *array = check_packed_array<T>(L, 1);
+	int64_t to = luaL_optinteger(L, 3, 0);
+	int64_t from = luaL_optinteger(L, 4, 0);
+	int64_t count = luaL_optinteger(L, 5, -1);
+	luaL_argcheck(L, to >= 0, 3, "negative index");
+	luaL_argcheck(L, from >= 0, 4, "negative index");
+
+	Vector<T> *source = lua_to_godot_packed_array_ptr<T>(L, 2);
+	int64_t source_size;
+	if (source) {
+		source_size = source->size();
+	} else {
+		luaL_argexpected(L, lua_istable(L, 2), 2, LuaPackedArrayType<T>::get_name());
+		source_size = lua_rawlen(L, 2);
+	}
+	if (count < 0) {
+		count = MAX(source_size - from, 0);
+	}
+	luaL_argcheck(L, from + count <= source_size, 5, "out of bounds of source");
+	if (count == 0) {
+		return 0;
+	}
+
+	if (to + count > array->size()) {
+		array->resize(to + count);
+	}
+	T *dst = array->ptrw() + to;
+	if (source) {
+		// After ptrw(), `source` may be the very same buffer.
+		memmove(dst, source->ptr() + from, count * sizeof(T));
+	} else {
+		for (int64_t i = 0; i < count; i++) {
+			lua_rawgeti(L, 2, from + i + 1);
+			dst[i] = LuaPackedArrayType<T>::check(L, -1);
+			lua_pop(L, 1);
+		}
+	}
+	return 0;
+}
+
+// Any other Godot method: runs on a Variant sharing the buffer, then takes it back so in-place methods such as `sort` stick.
+template <class T>
+static int packed_builtin_call(lua_State *L) {
+	const char *method = lua_tostring(L, lua_upvalueindex(1));
+	Vector<T> *array = check_packed_array<T>(L, 1);
+	Variant self = *array;
+	LUA_TO_ARGS(p_args, argcount, 2);
+	CALL_ERROR error;
+	VAR_VALL(self, method, p_args, argcount, ret, error);
+	*array = self.operator Vector<T>();
+	LuaScriptLanguage::push_variant(L, &ret);
+	return 1;
+}
+
+template <class T>
+static int packed_index(lua_State *L) {
+	if (lua_type(L, 2) == LUA_TNUMBER && lua_type(L, 1) == LUA_TUSERDATA) {
+		return packed_get<T>(L);
+	}
+
+	luaL_getmetatable(L, LuaPackedArrayType<T>::get_name()); // t|k|mt
+	lua_pushvalue(L, 2);
+	if (lua_rawget(L, -2) != LUA_TNIL) {
+		return 1;
+	}
+	lua_pop(L, 1);
+
+	const char *key = lua_tostring(L, 2);
+	if (key && Variant::has_builtin_method(LuaPackedArrayType<T>::get_type(), StringName(key))) {
+		lua_pushvalue(L, 2); // t|k|mt|k
+		lua_pushcclosure(L, &packed_builtin_call<T>, 1); // t|k|mt|f
+		lua_pushvalue(L, 2); // t|k|mt|f|k
+		lua_pushvalue(L, -2); // t|k|mt|f|k|f
+		lua_rawset(L, -4); // t|k|mt|f
+		return 1;
+	}
+	lua_pushnil(L);
+	return 1;
+}
+
+template <class T>
+static int packed_newindex(lua_State *L) {
+	if (lua_type(L, 2) != LUA_TNUMBER) {
+		return luaL_error(L, "cannot set field '%s' of %s", luaL_tolstring(L, 2, nullptr), LuaPackedArrayType<T>::get_name());
+	}
+	return packed_set<T>(L);
+}
+
+template <class T>
+static int packed_new(lua_State *L) {
+	// PackedFloat32Array(), PackedFloat32Array(size), PackedFloat32Array(array or table)
+	Vector<T> array;
+	if (lua_type(L, 2) == LUA_TNUMBER) {
+		int64_t size = luaL_checkinteger(L, 2);
+		luaL_argcheck(L, size >= 0, 2, "negative size");
+		array.resize(size);
+		memset(array.ptrw(), 0, size * sizeof(T));
+	} else if (Vector<T> *source = lua_to_godot_packed_array_ptr<T>(L, 2)) {
+		array = *source;
+	} else if (!lua_isnoneornil(L, 2)) {
+		array = lua_to_godot_variant(L, 2).operator Vector<T>();
+	}
+	lua_push_godot_packed_array(L, array);
+	return 1;
+}
+
+template <class T>
+static int packed_len(lua_State *L) {
+	lua_pushinteger(L, check_packed_array<T>(L, 1)->size());
+	return 1;
+}
+
+template <class T>
+static int packed_eq(lua_State *L) {
+	Vector<T> *a = lua_to_godot_packed_array_ptr<T>(L, 1);
+	Vector<T> *b = lua_to_godot_packed_array_ptr<T>(L, 2);
+	lua_pushboolean(L, a && b && *a == *b);
+	return 1;
+}
+
+template <class T>
+static int packed_tostring(lua_State *L) {
+	GD_STR_HOLD(str, Variant(*check_packed_array<T>(L, 1)).operator String());
+	lua_pushstring(L, str);
+	return 1;
+}
+
+template <class T>
+static int packed_gc(lua_State *L) {
+	// The class table shares the metatable, it has no array to release.
+	if (Vector<T> *array = lua_to_godot_packed_array_ptr<T>(L, 1)) {
+		array->~Vector<T>();
+	}
+	return 0;
+}
+
+template <class T>
+static Variant packed_array_to_variant(lua_State *L, int pos) {
+	return Variant(static_cast<LuaPackedArray<T> *>(lua_touserdata(L, pos))->array);
+}
+
+template <class T>
+static void push_packed_array_variant(lua_State *L, const Variant &var) {
+	lua_push_godot_packed_array(L, var.operator Vector<T>());
+}
+
+/**
+ * @brief Like the math value types, the metatable is also the global class table.
+ */
+template <class T>
+static void register_packed_array(lua_State *L) {
+	static const luaL_Reg methods[] = {
+		{ "append", &packed_push_back<T> },
+		{ "copy_from", &packed_copy_from<T> },
+		{ "fill", &packed_fill<T> },
+		{ "get", &packed_get<T> },
+		{ "is_empty", &packed_is_empty<T> },
+		{ "push_back", &packed_push_back<T> },
+		{ "resize", &packed_resize<T> },
+		{ "set", &packed_set<T> },
+		{ "size", &packed_size<T> },
+		{ "slice", &packed_slice<T> },
+		{ nullptr, nullptr },
+	};
+
+	const char *name = LuaPackedArrayType<T>::get_name();
+	luaL_newmetatable(L, name);
+	luaL_setfuncs(L, methods, 0);
+	luatable_rawset(L, -1, "__type", (lua_Integer)LuaPackedArrayType<T>::get_type());
+	LuaScriptLanguage::set_type_tag(L, -1, LuaPackedArrayType<T>::get_tag());
+	luatable_rawset(L, -1, "__index", &packed_index<T>);
+	luatable_rawset(L, -1, "__newindex", &packed_newindex<T>);
+	luatable_rawset(L, -1, "__len", &packed_len<T>);
+	luatable_rawset(L, -1, "__eq", &packed_eq<T>);
+	luatable_rawset(L, -1, "__tostring", &packed_tostring<T>);
+	luatable_rawset(L, -1, "__gc", &packed_gc<T>);
+	luatable_rawset(L, -1, "__call", &packed_new<T>);
+	luatable_rawset(L, -1, "new", &packed_new<T>);
+	lua_pushvalue(L, -1);
+	lua_setmetatable(L, -2);
+	lua_setglobal(L, name);
+}
+
+template <class T>
+static void register_packed_array_converters() {
+	LuaScriptLanguage::set_tag_converter(LuaPackedArrayType<T>::get_tag(), &packed_array_to_variant<T>);
+	LuaScriptLanguage::add_godot2lua(StringName(LuaPackedArrayType<T>::get_name()), &push_packed_array_variant<T>);
+}
+#endif
+
+void register_godot_packed_arrays(lua_State *L) {
+#ifndef GODOT_3_X
+	register_packed_array<uint8_t>(L);
+	register_packed_array<int32_t>(L);
+	register_packed_array<int64_t>(L);
+	register_packed_array<float>(L);
+	register_packed_array<double>(L);
+	register_packed_array<Vector2>(L);
+	register_packed_array<Vector3>(L);
+#endif
+}
+
+void register_godot_packed_array_converters() {
+#ifndef GODOT_3_X
+	register_packed_array_converters<uint8_t>();
+	register_packed_array_converters<int32_t>();
+	register_packed_array_converters<int64_t>();
+	register_packed_array_converters<float>();
+	register_packed_array_converters<double>();
+	register_packed_array_converters<Vector2>();
+	register_packed_array_converters<Vector3>();
+#endif
+}
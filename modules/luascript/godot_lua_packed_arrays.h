@@ -0,0 +1,112 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ *
+ */
+
+#pragma once
+
+#include "godot_lua_value_types.h"
+
+#ifndef GODOT_3_X
+/**
+ * @brief Full userdata of the numeric Packed*Array types.
+ * Holds a reference to the Godot buffer, pushing and converting back to Variant never copies,
+ * writing from Lua copies only if the buffer is shared, as `Vector` does.
+ */
+template <class T>
+struct LuaPackedArray {
+	Vector<T> array;
+};
+
+template <class T>
+struct LuaPackedArrayType;
+
+template <>
+struct LuaPackedArrayType<uint8_t> {
+	static const char *get_name() { return "PackedByteArray"; }
+	static Variant::Type get_type() { return Variant::PACKED_BYTE_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_BYTE_ARRAY; }
+	static void push(lua_State *L, uint8_t v) { lua_pushinteger(L, v); }
+	static uint8_t check(lua_State *L, int pos) { return uint8_t(luaL_checkinteger(L, pos)); }
+};
+
+template <>
+struct LuaPackedArrayType<int32_t> {
+	static const char *get_name() { return "PackedInt32Array"; }
+	static Variant::Type get_type() { return Variant::PACKED_INT32_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_INT32_ARRAY; }
+	static void push(lua_State *L, int32_t v) { lua_pushinteger(L, v); }
+	static int32_t check(lua_State *L, int pos) { return int32_t(luaL_checkinteger(L, pos)); }
+};
+
+template <>
+struct LuaPackedArrayType<int64_t> {
+	static const char *get_name() { return "PackedInt64Array"; }
+	static Variant::Type get_type() { return Variant::PACKED_INT64_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_INT64_ARRAY; }
+	static void push(lua_State *L, int64_t v) { lua_pushinteger(L, v); }
+	static int64_t check(lua_State *L, int pos) { return luaL_checkinteger(L, pos); }
+};
+
+template <>
+struct LuaPackedArrayType<float> {
+	static const char *get_name() { return "PackedFloat32Array"; }
+	static Variant::Type get_type() { return Variant::PACKED_FLOAT32_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_FLOAT32_ARRAY; }
+	static void push(lua_State *L, float v) { lua_pushnumber(L, v); }
+	static float check(lua_State *L, int pos) { return float(luaL_checknumber(L, pos)); }
+};
+
+template <>
+struct LuaPackedArrayType<double> {
+	static const char *get_name() { return "PackedFloat64Array"; }
+	static Variant::Type get_type() { return Variant::PACKED_FLOAT64_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_FLOAT64_ARRAY; }
+	static void push(lua_State *L, double v) { lua_pushnumber(L, v); }
+	static double check(lua_State *L, int pos) { return luaL_checknumber(L, pos); }
+};
+
+template <>
+struct LuaPackedArrayType<Vector2> {
+	static const char *get_name() { return "PackedVector2Array"; }
+	static Variant::Type get_type() { return Variant::PACKED_VECTOR2_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_VECTOR2_ARRAY; }
+	static void push(lua_State *L, const Vector2 &v) { lua_push_godot_value(L, v); }
+	static Vector2 check(lua_State *L, int pos);
+};
+
+template <>
+struct LuaPackedArrayType<Vector3> {
+	static const char *get_name() { return "PackedVector3Array"; }
+	static Variant::Type get_type() { return Variant::PACKED_VECTOR3_ARRAY; }
+	static LuaTypeTag get_tag() { return LUA_TAG_PACKED_VECTOR3_ARRAY; }
+	static void push(lua_State *L, const Vector3 &v) { lua_push_godot_value(L, v); }
+	static Vector3 check(lua_State *L, int pos);
+};
+
+template <class T>
+_FORCE_INLINE_ void lua_push_godot_packed_array(lua_State *L, const Vector<T> &p_array) {
+	auto udata = static_cast<LuaPackedArray<T> *>(lua_newuserdatauv(L, sizeof(LuaPackedArray<T>), 0));
+	memnew_placement(&udata->array, Vector<T>(p_array));
+	luaL_setmetatable(L, LuaPackedArrayType<T>::get_name());
+}
+
+/**
+ * @brief Returns the array held by the userdata at `pos`, nullptr if it is not a packed array of `T`
+ */
+template <class T>
+_FORCE_INLINE_ Vector<T> *lua_to_godot_packed_array_ptr(lua_State *L, int pos) {
+	auto udata = static_cast<LuaPackedArray<T> *>(luaL_testudata(L, pos, LuaPackedArrayType<T>::get_name()));
+	return udata ? &udata->array : nullptr;
+}
+#endif
+
+/**
+ * @brief Registers the packed array userdata in `L`, does nothing on Godot 3 where they stay Variant userdata
+ */
+void register_godot_packed_arrays(lua_State *L);
+
+/**
+ * @brief Registers the conversions from and to Variant, shared by all states
+ */
+void register_godot_packed_array_converters();
@@ -0,0 +1,752 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ *
+ */
+
+#include "godot_lua_value_types.h"
+#include "godot_lua_convert_api.h"
+
+template <class T>
+struct LuaValueConstant {
+	const char *name;
+	T value;
+};
+
+static const LuaValueConstant<Vector2> vector2_constants[] = {
+	{ "ZERO", Vector2(0, 0) },
+	{ "ONE", Vector2(1, 1) },
+	{ "LEFT", Vector2(-1, 0) },
+	{ "RIGHT", Vector2(1, 0) },
+	{ "UP", Vector2(0, -1) },
+	{ "DOWN", Vector2(0, 1) },
+	{ nullptr, Vector2() },
+};
+
+static const LuaValueConstant<Vector3> vector3_constants[] = {
+	{ "ZERO", Vector3(0, 0, 0) },
+	{ "ONE", Vector3(1, 1, 1) },
+	{ "LEFT", Vector3(-1, 0, 0) },
+	{ "RIGHT", Vector3(1, 0, 0) },
+	{ "UP", Vector3(0, 1, 0) },
+	{ "DOWN", Vector3(0, -1, 0) },
+	{ "FORWARD", Vector3(0, 0, -1) },
+	{ "BACK", Vector3(0, 0, 1) },
+	{ nullptr, Vector3() },
+};
+
+static const LuaValueConstant<Rect2> rect2_constants[] = {
+	{ nullptr, Rect2() },
+};
+
+template <class T>
+_FORCE_INLINE_ static T *check_value(lua_State *L, int pos) {
+	return static_cast<LuaValue<T> *>(luaL_checkudata(L, pos, LuaValueType<T>::get_name()))->ptr;
+}
+
+// Arguments accept any value Godot can convert, e.g. a Vector2i where a Vector2 is expected.
+template <class T>
+_FORCE_INLINE_ static T to_value(lua_State *L, int pos) {
+	if (T *v = lua_to_godot_value_ptr<T>(L, pos)) {
+		return *v;
+	}
+	return lua_to_godot_variant(L, pos);
+}
+
+/**
+ * @brief Pushes a `T` sharing the memory of `p_target`, which lives in the userdata at `p_owner`.
+ * Writing to the view writes to the owner, i.e. `rect.position.x = 1` behaves like in GDScript.
+ */
+template <class T>
+static void push_value_view(lua_State *L, T *p_target, int p_owner) {
+	p_owner = lua_absindex(L, p_owner);
+	auto udata = static_cast<LuaValue<T> *>(lua_newuserdatauv(L, sizeof(LuaValue<T>), 1));
+	udata->ptr = p_target;
+	luaL_setmetatable(L, LuaValueType<T>::get_name());
+	lua_pushvalue(L, p_owner);
+	lua_setiuservalue(L, -2, 1);
+}
+
+// `v.xy`, `v.yx`, `v.xzy`... a Vector2 for two letters, a Vector3 for three.
+static bool push_swizzle(lua_State *L, const real_t *p_components, int p_count, const char *p_key, size_t p_len) {
+	if (p_len < 2 || p_len > 3) {
+		return false;
+	}
+	real_t values[3];
+	for (size_t i = 0; i < p_len; i++) {
+		int axis = p_key[i] - 'x';
+		if (axis < 0 || axis >= p_count) {
+			return false;
+		}
+		values[i] = p_components[axis];
+	}
+	if (p_len == 2) {
+		lua_push_godot_value(L, Vector2(values[0], values[1]));
+	} else {
+		lua_push_godot_value(L, Vector3(values[0], values[1], values[2]));
+	}
+	return true;
+}
+
+template <class T>
+static int value_builtin_call(lua_State *L) {
+	const char *method = lua_tostring(L, lua_upvalueindex(1));
+	Variant self = *check_value<T>(L, 1);
+	LUA_TO_ARGS(p_args, argcount, 2);
+	CALL_ERROR error;
+	VAR_VALL(self, method, p_args, argcount, ret, error);
+	LuaScriptLanguage::push_variant(L, &ret);
+	return 1;
+}
+
+/**
+ * @brief Lookup shared by the values and their class table: native methods, constants,
+ * then any other Godot builtin method, whose closure is cached in the metatable.
+ */
+template <class T>
+static int index_value_class(lua_State *L, const LuaValueConstant<T> *p_constants) {
+	luaL_getmetatable(L, LuaValueType<T>::get_name()); // t|k|mt
+	lua_pushvalue(L, 2);
+	if (lua_rawget(L, -2) != LUA_TNIL) {
+		return 1;
+	}
+	lua_pop(L, 1);
+
+	const char *key = lua_tostring(L, 2);
+	if (key == nullptr) {
+		lua_pushnil(L);
+		return 1;
+	}
+	for (const LuaValueConstant<T> *c = p_constants; c->name; c++) {
+		if (strcmp(key, c->name) == 0) {
+			lua_push_godot_value(L, c->value);
+			return 1;
+		}
+	}
+
+	StringName method(key);
+#ifdef GODOT_3_X
+	bool has_method = Variant(T()).has_method(method);
+#else
+	bool has_method = Variant::has_builtin_method(LuaValueType<T>::get_type(), method);
+#endif
+	if (has_method) {
+		lua_pushvalue(L, 2); // t|k|mt|k
+		lua_pushcclosure(L, &value_builtin_call<T>, 1); // t|k|mt|f
+		lua_pushvalue(L, 2); // t|k|mt|f|k
+		lua_pushvalue(L, -2); // t|k|mt|f|k|f
+		lua_rawset(L, -4); // t|k|mt|f
+		return 1;
+	}
+	lua_pushnil(L);
+	return 1;
+}
+
+template <class T>
+static int value_new(lua_State *L);
+
+template <>
+int value_new<Vector2>(lua_State *L) {
+	// Vector2(x, y), Vector2:new(x, y), Vector2(v)
+	Vector2 v;
+	if (lua_type(L, 2) == LUA_TNUMBER) {
+		v = Vector2(lua_tonumber(L, 2), luaL_optnumber(L, 3, 0));
+	} else if (Vector3 *v3 = lua_to_godot_value_ptr<Vector3>(L, 2)) {
+		v = Vector2(v3->x, v3->y);
+	} else if (!lua_isnoneornil(L, 2)) {
+		v = to_value<Vector2>(L, 2);
+	}
+	lua_push_godot_value(L, v);
+	return 1;
+}
+
+template <>
+int value_new<Vector3>(lua_State *L) {
+	// Vector3(x, y, z), Vector3:new(x, y, z), Vector3(v)
+	Vector3 v;
+	if (lua_type(L, 2) == LUA_TNUMBER) {
+		v = Vector3(lua_tonumber(L, 2), luaL_optnumber(L, 3, 0), luaL_optnumber(L, 4, 0));
+	} else if (Vector2 *v2 = lua_to_godot_value_ptr<Vector2>(L, 2)) {
+		v = Vector3(v2->x, v2->y, luaL_optnumber(L, 3, 0));
+	} else if (!lua_isnoneornil(L, 2)) {
+		v = to_value<Vector3>(L, 2);
+	}
+	lua_push_godot_value(L, v);
+	return 1;
+}
+
+template <>
+int value_new<Rect2>(lua_State *L) {
+	// Rect2(x, y, w, h), Rect2(position, size), Rect2(r)
+	Rect2 r;
+	if (lua_type(L, 2) == LUA_TNUMBER) {
+		r = Rect2(lua_tonumber(L, 2), luaL_optnumber(L, 3, 0), luaL_optnumber(L, 4, 0), luaL_optnumber(L, 5, 0));
+	} else if (!lua_isnoneornil(L, 3)) {
+		r = Rect2(to_value<Vector2>(L, 2), to_value<Vector2>(L, 3));
+	} else if (!lua_isnoneornil(L, 2)) {
+		r = to_value<Rect2>(L, 2);
+	}
+	lua_push_godot_value(L, r);
+	return 1;
+}
+
+template <class T>
+static int value_tostring(lua_State *L) {
+	GD_STR_HOLD(str, (String)*check_value<T>(L, 1));
+	lua_pushstring(L, str);
+	return 1;
+}
+
+template <class T>
+static int value_eq(lua_State *L) {
+	T *a = lua_to_godot_value_ptr<T>(L, 1);
+	T *b = lua_to_godot_value_ptr<T>(L, 2);
+	lua_pushboolean(L, a && b && a->is_equal_approx(*b));
+	return 1;
+}
+
+// Operands that are not both values of this type, e.g. `v * transform`, go through Godot.
+template <class T>
+static int value_evaluate(lua_State *L, Variant::Operator p_op) {
+	Variant a = lua_to_godot_variant(L, 1);
+	Variant b = lua_to_godot_variant(L, 2);
+	Variant ret;
+	bool valid = false;
+	Variant::evaluate(p_op, a, b, ret, valid);
+	if (!valid) {
+		return luaL_error(L, "invalid operands for %s", LuaValueType<T>::get_name());
+	}
+	LuaScriptLanguage::push_variant(L, &ret);
+	return 1;
+}
+
+template <class T>
+static int value_add(lua_State *L) {
+	T *a = lua_to_godot_value_ptr<T>(L, 1);
+	T *b = lua_to_godot_value_ptr<T>(L, 2);
+	if (a && b) {
+		lua_push_godot_value(L, *a + *b);
+		return 1;
+	}
+	return value_evaluate<T>(L, Variant::OP_ADD);
+}
+
+template <class T>
+static int value_sub(lua_State *L) {
+	T *a = lua_to_godot_value_ptr<T>(L, 1);
+	T *b = lua_to_godot_value_ptr<T>(L, 2);
+	if (a && b) {
+		lua_push_godot_value(L, *a - *b);
+		return 1;
+	}
+	return value_evaluate<T>(L, Variant::OP_SUBTRACT);
+}
+
+template <class T>
+static int value_mul(lua_State *L) {
+	T *a = lua_to_godot_value_ptr<T>(L, 1);
+	T *b = lua_to_godot_value_ptr<T>(L, 2);
+	if (a && b) {
+		lua_push_godot_value(L, *a * *b);
+	} else if (a && lua_type(L, 2) == LUA_TNUMBER) {
+		lua_push_godot_value(L, *a * real_t(lua_tonumber(L, 2)));
+	} else if (b && lua_type(L, 1) == LUA_TNUMBER) {
+		lua_push_godot_value(L, *b * real_t(lua_tonumber(L, 1)));
+	} else {
+		return value_evaluate<T>(L, Variant::OP_MULTIPLY);
+	}
+	return 1;
+}
+
+template <class T>
+static int value_div(lua_State *L) {
+	T *a = lua_to_godot_value_ptr<T>(L, 1);
+	T *b = lua_to_godot_value_ptr<T>(L, 2);
+	if (a && b) {
+		lua_push_godot_value(L, *a / *b);
+	} else if (a && lua_type(L, 2) == LUA_TNUMBER) {
+		lua_push_godot_value(L, *a / real_t(lua_tonumber(L, 2)));
+	} else {
+		return value_evaluate<T>(L, Variant::OP_DIVIDE);
+	}
+	return 1;
+}
+
+template <class T>
+static int value_unm(lua_State *L) {
+	lua_push_godot_value(L, -*check_value<T>(L, 1));
+	return 1;
+}
+
+template <class T>
+static int value_length(lua_State *L) {
+	lua_pushnumber(L, check_value<T>(L, 1)->length());
+	return 1;
+}
+
+template <class T>
+static int value_length_squared(lua_State *L) {
+	lua_pushnumber(L, check_value<T>(L, 1)->length_squared());
+	return 1;
+}
+
+template <class T>
+static int value_normalize(lua_State *L) {
+	check_value<T>(L, 1)->normalize();
+	return 0;
+}
+
+template <class T>
+static int value_normalized(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->normalized());
+	return 1;
+}
+
+template <class T>
+static int value_is_normalized(lua_State *L) {
+	lua_pushboolean(L, check_value<T>(L, 1)->is_normalized());
+	return 1;
+}
+
+template <class T>
+static int value_distance_to(lua_State *L) {
+	lua_pushnumber(L, check_value<T>(L, 1)->distance_to(to_value<T>(L, 2)));
+	return 1;
+}
+
+template <class T>
+static int value_distance_squared_to(lua_State *L) {
+	lua_pushnumber(L, check_value<T>(L, 1)->distance_squared_to(to_value<T>(L, 2)));
+	return 1;
+}
+
+template <class T>
+static int value_dot(lua_State *L) {
+	lua_pushnumber(L, check_value<T>(L, 1)->dot(to_value<T>(L, 2)));
+	return 1;
+}
+
+template <class T>
+static int value_angle_to(lua_State *L) {
+	lua_pushnumber(L, check_value<T>(L, 1)->angle_to(to_value<T>(L, 2)));
+	return 1;
+}
+
+template <class T>
+static int value_abs(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->abs());
+	return 1;
+}
+
+template <class T>
+static int value_floor(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->floor());
+	return 1;
+}
+
+template <class T>
+static int value_ceil(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->ceil());
+	return 1;
+}
+
+template <class T>
+static int value_round(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->round());
+	return 1;
+}
+
+template <class T>
+static int value_sign(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->sign());
+	return 1;
+}
+
+template <class T>
+static int value_lerp(lua_State *L) {
+	T from = *check_value<T>(L, 1);
+	lua_push_godot_value(L, from + (to_value<T>(L, 2) - from) * real_t(luaL_checknumber(L, 3)));
+	return 1;
+}
+
+template <class T>
+static int value_limit_length(lua_State *L) {
+	T v = *check_value<T>(L, 1);
+	real_t limit = luaL_optnumber(L, 2, 1.0);
+	real_t length = v.length();
+	if (length > 0 && limit < length) {
+		v = v / length * limit;
+	}
+	lua_push_godot_value(L, v);
+	return 1;
+}
+
+template <class T>
+static int value_move_toward(lua_State *L) {
+	lua_push_godot_value(L, check_value<T>(L, 1)->move_toward(to_value<T>(L, 2), luaL_checknumber(L, 3)));
+	return 1;
+}
+
+template <class T>
+static int value_is_equal_approx(lua_State *L) {
+	lua_pushboolean(L, check_value<T>(L, 1)->is_equal_approx(to_value<T>(L, 2)));
+	return 1;
+}
+
+static int vector2_index(lua_State *L) {
+	if (lua_type(L, 2) == LUA_TSTRING) {
+		if (Vector2 *self = lua_to_godot_value_ptr<Vector2>(L, 1)) {
+			size_t len;
+			const char *key = lua_tolstring(L, 2, &len);
+			if (len == 1) {
+				switch (key[0]) {
+					case 'x':
+						lua_pushnumber(L, self->x);
+						return 1;
+					case 'y':
+						lua_pushnumber(L, self->y);
+						return 1;
+				}
+			} else if (push_swizzle(L, &self->x, 2, key, len)) {
+				return 1;
+			}
+		}
+	}
+	return index_value_class<Vector2>(L, vector2_constants);
+}
+
+static int vector2_newindex(lua_State *L) {
+	Vector2 *self = check_value<Vector2>(L, 1);
+	const char *key = luaL_checkstring(L, 2);
+	if (strcmp(key, "x") == 0) {
+		self->x = luaL_checknumber(L, 3);
+	} else if (strcmp(key, "y") == 0) {
+		self->y = luaL_checknumber(L, 3);
+	}
+	return 0;
+}
+
+static int vector2_angle(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1)->angle());
+	return 1;
+}
+
+static int vector2_cross(lua_State *L) {
+	lua_pushnumber(L, check_value<Vector2>(L, 1)->cross(to_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static int vector2_rotated(lua_State *L) {
+	lua_push_godot_value(L, check_value<Vector2>(L, 1)->rotated(luaL_checknumber(L, 2)));
+	return 1;
+}
+
+static int vector2_set_rotation(lua_State *L) {
+	Vector2 *self = check_value<Vector2>(L, 1);
+	real_t radians = luaL_checknumber(L, 2);
+	self->x = Math::cos(radians);
+	self->y = Math::sin(radians);
+	return 0;
+}
+
+static const luaL_Reg vector2_methods[] = {
+	{ "__add", &value_add<Vector2> },
+	{ "__sub", &value_sub<Vector2> },
+	{ "__mul", &value_mul<Vector2> },
+	{ "__div", &value_div<Vector2> },
+	{ "__unm", &value_unm<Vector2> },
+	{ "abs", &value_abs<Vector2> },
+	{ "angle", &vector2_angle },
+	{ "angle_to", &value_angle_to<Vector2> },
+	{ "ceil", &value_ceil<Vector2> },
+	{ "clamped", &value_limit_length<Vector2> },
+	{ "cross", &vector2_cross },
+	{ "distance_squared_to", &value_distance_squared_to<Vector2> },
+	{ "distance_to", &value_distance_to<Vector2> },
+	{ "dot", &value_dot<Vector2> },
+	{ "floor", &value_floor<Vector2> },
+	{ "is_equal_approx", &value_is_equal_approx<Vector2> },
+	{ "is_normalized", &value_is_normalized<Vector2> },
+	{ "length", &value_length<Vector2> },
+	{ "length_squared", &value_length_squared<Vector2> },
+	{ "lerp", &value_lerp<Vector2> },
+	{ "limit_length", &value_limit_length<Vector2> },
+	{ "linear_interpolate", &value_lerp<Vector2> },
+	{ "move_toward", &value_move_toward<Vector2> },
+	{ "normalize", &value_normalize<Vector2> },
+	{ "normalized", &value_normalized<Vector2> },
+	{ "rotated", &vector2_rotated },
+	{ "round", &value_round<Vector2> },
+	{ "set_rotation", &vector2_set_rotation },
+	{ "sign", &value_sign<Vector2> },
+	{ nullptr, nullptr },
+};
+
+static int vector3_index(lua_State *L) {
+	if (lua_type(L, 2) == LUA_TSTRING) {
+		if (Vector3 *self = lua_to_godot_value_ptr<Vector3>(L, 1)) {
+			size_t len;
+			const char *key = lua_tolstring(L, 2, &len);
+			if (len == 1) {
+				switch (key[0]) {
+					case 'x':
+						lua_pushnumber(L, self->x);
+						return 1;
+					case 'y':
+						lua_pushnumber(L, self->y);
+						return 1;
+					case 'z':
+						lua_pushnumber(L, self->z);
+						return 1;
+				}
+			} else if (push_swizzle(L, &self->x, 3, key, len)) {
+				return 1;
+			}
+		}
+	}
+	return index_value_class<Vector3>(L, vector3_constants);
+}
+
+static int vector3_newindex(lua_State *L) {
+	Vector3 *self = check_value<Vector3>(L, 1);
+	const char *key = luaL_checkstring(L, 2);
+	if (strcmp(key, "x") == 0) {
+		self->x = luaL_checknumber(L, 3);
+	} else if (strcmp(key, "y") == 0) {
+		self->y = luaL_checknumber(L, 3);
+	} else if (strcmp(key, "z") == 0) {
+		self->z = luaL_checknumber(L, 3);
+	}
+	return 0;
+}
+
+static int vector3_cross(lua_State *L) {
+	lua_push_godot_value(L, check_value<Vector3>(L, 1)->cross(to_value<Vector3>(L, 2)));
+	return 1;
+}
+
+static int vector3_inverse(lua_State *L) {
+	lua_push_godot_value(L, check_value<Vector3>(L, 1)->inverse());
+	return 1;
+}
+
+static int vector3_max_axis(lua_State *L) {
+	const Vector3 *self = check_value<Vector3>(L, 1);
+	lua_pushinteger(L, self->x < self->y ? (self->y < self->z ? 2 : 1) : (self->x < self->z ? 2 : 0));
+	return 1;
+}
+
+static int vector3_min_axis(lua_State *L) {
+	const Vector3 *self = check_value<Vector3>(L, 1);
+	lua_pushinteger(L, self->x < self->y ? (self->x < self->z ? 0 : 2) : (self->y < self->z ? 1 : 2));
+	return 1;
+}
+
+static int vector3_to_diagonal_matrix(lua_State *L) {
+	const Vector3 *self = check_value<Vector3>(L, 1);
+	Variant ret = Basis(self->x, 0, 0, 0, self->y, 0, 0, 0, self->z);
+	LuaScriptLanguage::push_variant(L, &ret);
+	return 1;
+}
+
+static const luaL_Reg vector3_methods[] = {
+	{ "__add", &value_add<Vector3> },
+	{ "__sub", &value_sub<Vector3> },
+	{ "__mul", &value_mul<Vector3> },
+	{ "__div", &value_div<Vector3> },
+	{ "__unm", &value_unm<Vector3> },
+	{ "abs", &value_abs<Vector3> },
+	{ "angle_to", &value_angle_to<Vector3> },
+	{ "ceil", &value_ceil<Vector3> },
+	{ "cross", &vector3_cross },
+	{ "distance_squared_to", &value_distance_squared_to<Vector3> },
+	{ "distance_to", &value_distance_to<Vector3> },
+	{ "dot", &value_dot<Vector3> },
+	{ "floor", &value_floor<Vector3> },
+	{ "inverse", &vector3_inverse },
+	{ "is_equal_approx", &value_is_equal_approx<Vector3> },
+	{ "is_normalized", &value_is_normalized<Vector3> },
+	{ "length", &value_length<Vector3> },
+	{ "length_squared", &value_length_squared<Vector3> },
+	{ "lerp", &value_lerp<Vector3> },
+	{ "limit_length", &value_limit_length<Vector3> },
+	{ "linear_interpolate", &value_lerp<Vector3> },
+	{ "max_axis", &vector3_max_axis },
+	{ "min_axis", &vector3_min_axis },
+	{ "move_toward", &value_move_toward<Vector3> },
+	{ "normalize", &value_normalize<Vector3> },
+	{ "normalized", &value_normalized<Vector3> },
+	{ "round", &value_round<Vector3> },
+	{ "sign", &value_sign<Vector3> },
+	{ "to_diagonal_matrix", &vector3_to_diagonal_matrix },
+	{ nullptr, nullptr },
+};
+
+static int rect2_index(lua_State *L) {
+	if (lua_type(L, 2) == LUA_TSTRING) {
+		if (Rect2 *self = lua_to_godot_value_ptr<Rect2>(L, 1)) {
+			const char *key = lua_tostring(L, 2);
+			if (strcmp(key, "position") == 0) {
+				push_value_view(L, &self->position, 1);
+				return 1;
+			} else if (strcmp(key, "size") == 0) {
+				push_value_view(L, &self->size, 1);
+				return 1;
+			} else if (strcmp(key, "end") == 0) {
+				lua_push_godot_value(L, self->position + self->size);
+				return 1;
+			}
+		}
+	}
+	return index_value_class<Rect2>(L, rect2_constants);
+}
+
+static int rect2_newindex(lua_State *L) {
+	Rect2 *self = check_value<Rect2>(L, 1);
+	const char *key = luaL_checkstring(L, 2);
+	if (strcmp(key, "position") == 0) {
+		self->position = to_value<Vector2>(L, 3);
+	} else if (strcmp(key, "size") == 0) {
+		self->size = to_value<Vector2>(L, 3);
+	} else if (strcmp(key, "end") == 0) {
+		self->size = to_value<Vector2>(L, 3) - self->position;
+	}
+	return 0;
+}
+
+static int rect2_clip(lua_State *L) {
+#ifdef GODOT_3_X
+	lua_push_godot_value(L, check_value<Rect2>(L, 1)->clip(to_value<Rect2>(L, 2)));
+#else
+	lua_push_godot_value(L, check_value<Rect2>(L, 1)->intersection(to_value<Rect2>(L, 2)));
+#endif
+	return 1;
+}
+
+static int rect2_encloses(lua_State *L) {
+	lua_pushboolean(L, check_value<Rect2>(L, 1)->encloses(to_value<Rect2>(L, 2)));
+	return 1;
+}
+
+static int rect2_expand(lua_State *L) {
+	lua_push_godot_value(L, check_value<Rect2>(L, 1)->expand(to_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static int rect2_get_area(lua_State *L) {
+	lua_pushnumber(L, check_value<Rect2>(L, 1)->get_area());
+	return 1;
+}
+
+static int rect2_get_center(lua_State *L) {
+	const Rect2 *self = check_value<Rect2>(L, 1);
+	lua_push_godot_value(L, self->position + self->size * 0.5);
+	return 1;
+}
+
+static int rect2_grow(lua_State *L) {
+	lua_push_godot_value(L, check_value<Rect2>(L, 1)->grow(luaL_checknumber(L, 2)));
+	return 1;
+}
+
+static int rect2_grow_individual(lua_State *L) {
+	lua_push_godot_value(L, check_value<Rect2>(L, 1)->grow_individual(luaL_checknumber(L, 2), luaL_checknumber(L, 3), luaL_checknumber(L, 4), luaL_checknumber(L, 5)));
+	return 1;
+}
+
+static int rect2_grow_margin(lua_State *L) {
+	const Rect2 *self = check_value<Rect2>(L, 1);
+	lua_Integer margin = luaL_checkinteger(L, 2);
+	real_t by = luaL_checknumber(L, 3);
+	lua_push_godot_value(L, self->grow_individual(margin == 0 ? by : 0, margin == 1 ? by : 0, margin == 2 ? by : 0, margin == 3 ? by : 0));
+	return 1;
+}
+
+static int rect2_has_no_area(lua_State *L) {
+	const Rect2 *self = check_value<Rect2>(L, 1);
+	lua_pushboolean(L, self->size.x <= 0 || self->size.y <= 0);
+	return 1;
+}
+
+static int rect2_has_point(lua_State *L) {
+	lua_pushboolean(L, check_value<Rect2>(L, 1)->has_point(to_value<Vector2>(L, 2)));
+	return 1;
+}
+
+static int rect2_intersects(lua_State *L) {
+	lua_pushboolean(L, check_value<Rect2>(L, 1)->intersects(to_value<Rect2>(L, 2), lua_toboolean(L, 3)));
+	return 1;
+}
+
+static int rect2_merge(lua_State *L) {
+	lua_push_godot_value(L, check_value<Rect2>(L, 1)->merge(to_value<Rect2>(L, 2)));
+	return 1;
+}
+
+static const luaL_Reg rect2_methods[] = {
+	{ "abs", &value_abs<Rect2> },
+	{ "clip", &rect2_clip },
+	{ "encloses", &rect2_encloses },
+	{ "expand", &rect2_expand },
+	{ "get_area", &rect2_get_area },
+	{ "get_center", &rect2_get_center },
+	{ "grow", &rect2_grow },
+	{ "grow_individual", &rect2_grow_individual },
+	{ "grow_margin", &rect2_grow_margin },
+	{ "has_no_area", &rect2_has_no_area },
+	{ "has_point", &rect2_has_point },
+	{ "intersects", &rect2_intersects },
+	{ "is_equal_approx", &value_is_equal_approx<Rect2> },
+	{ "merge", &rect2_merge },
+	{ nullptr, nullptr },
+};
+
+/**
+ * @brief The metatable is also the global class table, calling it constructs a value.
+ */
+template <class T>
+static void register_value_type(lua_State *L, const luaL_Reg *p_methods, lua_CFunction p_index, lua_CFunction p_newindex) {
+	const char *name = LuaValueType<T>::get_name();
+	luaL_newmetatable(L, name);
+	luaL_setfuncs(L, p_methods, 0);
+	luatable_rawset(L, -1, "__type", (lua_Integer)LuaValueType<T>::get_type());
+	LuaScriptLanguage::set_type_tag(L, -1, LuaValueType<T>::get_tag());
+	luatable_rawset(L, -1, "__index", p_index);
+	luatable_rawset(L, -1, "__newindex", p_newindex);
+	luatable_rawset(L, -1, "__call", &value_new<T>);
+	luatable_rawset(L, -1, "new", &value_new<T>);
+	luatable_rawset(L, -1, "__eq", &value_eq<T>);
+	luatable_rawset(L, -1, "__tostring", &value_tostring<T>);
+	lua_pushvalue(L, -1);
+	lua_setmetatable(L, -2);
+	lua_setglobal(L, name);
+}
+
+/**
+ * @brief Tag converter, copies the value out of the userdata
+ */
+template <class T>
+static Variant value_to_variant(lua_State *L, int pos) {
+	return Variant(*static_cast<LuaValue<T> *>(lua_touserdata(L, pos))->ptr);
+}
+
+void register_godot_value_types(lua_State *L) {
+	register_value_type<Vector2>(L, vector2_methods, &vector2_index, &vector2_newindex);
+	register_value_type<Vector3>(L, vector3_methods, &vector3_index, &vector3_newindex);
+	register_value_type<Rect2>(L, rect2_methods, &rect2_index, &rect2_newindex);
+
+	luaL_getmetatable(L, "Vector2");
+	luatable_rawset(L, -1, "AXIS_X", (lua_Integer)0);
+	luatable_rawset(L, -1, "AXIS_Y", (lua_Integer)1);
+	lua_pop(L, 1);
+	luaL_getmetatable(L, "Vector3");
+	luatable_rawset(L, -1, "AXIS_X", (lua_Integer)0);
+	luatable_rawset(L, -1, "AXIS_Y", (lua_Integer)1);
+	luatable_rawset(L, -1, "AXIS_Z", (lua_Integer)2);
+	lua_pop(L, 1);
+}
+
+void register_godot_value_converters() {
+	LuaScriptLanguage::set_tag_converter(LUA_TAG_VECTOR2, &value_to_variant<Vector2>);
+	LuaScriptLanguage::set_tag_converter(LUA_TAG_VECTOR3, &value_to_variant<Vector3>);
+	LuaScriptLanguage::set_tag_converter(LUA_TAG_RECT2, &value_to_variant<Rect2>);
+}
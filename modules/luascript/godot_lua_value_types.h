@@ -0,0 +1,70 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ *
+ */
+
+#pragma once
+
+#include "lib/lua/lua.hpp"
+#include "luascript_language.h"
+
+/**
+ * @brief Full userdata of the math value types (Vector2, Vector3, Rect2).
+ * `ptr` points to `value`, or into the userdata kept in the first user value for views such as `Rect2.position`.
+ */
+template <class T>
+struct LuaValue {
+	T *ptr;
+	T value;
+};
+
+template <class T>
+struct LuaValueType;
+
+template <>
+struct LuaValueType<Vector2> {
+	static const char *get_name() { return "Vector2"; }
+	static Variant::Type get_type() { return Variant::VECTOR2; }
+	static LuaTypeTag get_tag() { return LUA_TAG_VECTOR2; }
+};
+
+template <>
+struct LuaValueType<Vector3> {
+	static const char *get_name() { return "Vector3"; }
+	static Variant::Type get_type() { return Variant::VECTOR3; }
+	static LuaTypeTag get_tag() { return LUA_TAG_VECTOR3; }
+};
+
+template <>
+struct LuaValueType<Rect2> {
+	static const char *get_name() { return "Rect2"; }
+	static Variant::Type get_type() { return Variant::RECT2; }
+	static LuaTypeTag get_tag() { return LUA_TAG_RECT2; }
+};
+
+template <class T>
+_FORCE_INLINE_ void lua_push_godot_value(lua_State *L, const T &p_value) {
+	auto udata = static_cast<LuaValue<T> *>(lua_newuserdatauv(L, sizeof(LuaValue<T>), 0));
+	udata->value = p_value;
+	udata->ptr = &udata->value;
+	luaL_setmetatable(L, LuaValueType<T>::get_name());
+}
+
+/**
+ * @brief Returns the value held by the userdata at `pos`, nullptr if it is not a `T`
+ */
+template <class T>
+_FORCE_INLINE_ T *lua_to_godot_value_ptr(lua_State *L, int pos) {
+	auto udata = static_cast<LuaValue<T> *>(luaL_testudata(L, pos, LuaValueType<T>::get_name()));
+	return udata ? udata->ptr : nullptr;
+}
+
+/**
+ * @brief Creates the metatables and class tables in `L`, it only touches that state
+ */
+void register_godot_value_types(lua_State *L);
+
+/**
+ * @brief Registers the conversions to Variant, shared by all states
+ */
+void register_godot_value_converters();
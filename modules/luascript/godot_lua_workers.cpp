@@ -0,0 +1,458 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ * Lua workers: isolated Lua states running Lua functions on the WorkerThreadPool.
+ *
+ * 	local job = LuaWorkers.run("res://ai/paths.lua", "solve", { input1, input2 })
+ * 	local results, errors = job:wait()
+ *
+ * The module returns a table of functions, `solve` is called once per input on the worker states
+ * and the results come back in the same order. Each worker state loads the module once per job,
+ * with its own globals, from the chunk compiled once by the main state until the script reloads.
+ * Only data crosses states, as a copy:
+ * nil, booleans, numbers, strings, tables of them, Vector2, Vector3, Rect2 and the numeric
+ * packed arrays, whose buffer is shared rather than copied.
+ */
+
+#include "godot_lua_cfuntions.h"
+#include "godot_lua_convert_api.h"
+#include "godot_lua_packed_arrays.h"
+#include "godot_lua_table_api.h"
+
+#ifndef GODOT_3_X
+#include "core/object/worker_thread_pool.h"
+
+#define LUA_WORKER_JOB "LuaWorkerJob"
+#define LUA_WORKER_MAX_DEPTH 64
+
+struct LuaWorkerJob {
+	uint64_t id = 0;
+	Vector<uint8_t> chunk;
+	CharString path;
+	CharString function;
+	LocalVector<Variant> inputs;
+	LocalVector<Variant> results;
+	LocalVector<String> errors;
+	WorkerThreadPool::GroupID group = -1;
+	bool waited = false;
+};
+
+static Mutex workers_mutex;
+static LocalVector<lua_State *> idle_states;
+static HashMap<String, Vector<uint8_t>> worker_chunks; // Only used by the main state.
+static uint64_t last_worker_job_id = 0; // Only used by the main state.
+static char worker_module_key = 0;
+static char worker_module_job_key = 0;
+
+// Lua value to Variant, for the data going to or coming back from a worker.
+static bool to_worker_variant(lua_State *L, int pos, Variant &r_value, int p_depth, String &r_error) {
+	pos = lua_absindex(L, pos);
+	switch (lua_type(L, pos)) {
+		case LUA_TNIL:
+			r_value = Variant();
+			return true;
+		case LUA_TBOOLEAN:
+			r_value = bool(lua_toboolean(L, pos));
+			return true;
+		case LUA_TNUMBER:
+			r_value = lua_isinteger(L, pos) ? Variant((int64_t)lua_tointeger(L, pos)) : Variant(lua_tonumber(L, pos));
+			return true;
+		case LUA_TSTRING:
+			r_value = String::utf8(lua_tostring(L, pos));
+			return true;
+		case LUA_TUSERDATA: {
+			// Value types and packed arrays, not objects nor Variant userdata which may hold one.
+			auto tag = LuaScriptLanguage::get_type_tag(L, pos);
+			if (tag > LUA_TAG_VARIANT) {
+				r_value = LuaScriptLanguage::find_tag_converter(tag)(L, pos);
+				return true;
+			}
+		} break;
+		case LUA_TTABLE: {
+			if (lua_getmetatable(L, pos)) {
+				// Objects, scripts and classes
+				lua_pop(L, 1);
+				break;
+			}
+			if (p_depth >= LUA_WORKER_MAX_DEPTH || !lua_checkstack(L, 3)) {
+				r_error = "tables nested too deep, or cyclic";
+				return false;
+			}
+			// An Array when the keys are exactly 1..#t, anything else, mixed tables included, becomes a Dictionary.
+			lua_Integer length = lua_rawlen(L, pos);
+			lua_Integer count = 0;
+			bool is_array = true;
+			lua_pushnil(L);
+			while (lua_next(L, pos)) {
+				lua_pop(L, 1);
+				lua_Integer index = lua_isinteger(L, -1) ? lua_tointeger(L, -1) : 0;
+				if (index < 1 || index > length) {
+					is_array = false;
+					lua_pop(L, 1);
+					break;
+				}
+				count++;
+			}
+			if (is_array && count == length) {
+				Array array;
+				array.resize(length);
+				for (int i = 0; i < array.size(); i++) {
+					lua_rawgeti(L, pos, i + 1);
+					Variant value;
+					bool valid = to_worker_variant(L, -1, value, p_depth + 1, r_error);
+					lua_pop(L, 1);
+					if (!valid) {
+						return false;
+					}
+					array[i] = value;
+				}
+				r_value = array;
+			} else {
+				Dictionary dict;
+				lua_pushnil(L);
+				while (lua_next(L, pos)) {
+					Variant key, value;
+					if (!to_worker_variant(L, -2, key, p_depth + 1, r_error) || !to_worker_variant(L, -1, value, p_depth + 1, r_error)) {
+						lua_pop(L, 2);
+						return false;
+					}
+					dict[key] = value;
+					lua_pop(L, 1);
+				}
+				r_value = dict;
+			}
+			return true;
+		}
+		default:
+			break;
+	}
+	r_error = vformat("a %s can't be passed to or from a Lua worker", luaL_typename(L, pos));
+	return false;
+}
+
+// Variant to Lua value in a worker state, `p_value` went through `to_worker_variant`.
+static void push_worker_variant(lua_State *L, const Variant &p_value) {
+	lua_checkstack(L, 3);
+	switch (p_value.get_type()) {
+		case Variant::BOOL:
+			lua_pushboolean(L, p_value.operator bool());
+			break;
+		case Variant::INT:
+			lua_pushinteger(L, p_value.operator int64_t());
+			break;
+		case Variant::FLOAT:
+			lua_pushnumber(L, p_value.operator double());
+			break;
+		case Variant::STRING:
+			lua_pushstring(L, GD_UTF8_STR(p_value.operator String()));
+			break;
+		case Variant::VECTOR2:
+			lua_push_godot_value(L, p_value.operator Vector2());
+			break;
+		case Variant::VECTOR3:
+			lua_push_godot_value(L, p_value.operator Vector3());
+			break;
+		case Variant::RECT2:
+			lua_push_godot_value(L, p_value.operator Rect2());
+			break;
+		case Variant::PACKED_BYTE_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedByteArray());
+			break;
+		case Variant::PACKED_INT32_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedInt32Array());
+			break;
+		case Variant::PACKED_INT64_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedInt64Array());
+			break;
+		case Variant::PACKED_FLOAT32_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedFloat32Array());
+			break;
+		case Variant::PACKED_FLOAT64_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedFloat64Array());
+			break;
+		case Variant::PACKED_VECTOR2_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedVector2Array());
+			break;
+		case Variant::PACKED_VECTOR3_ARRAY:
+			lua_push_godot_packed_array(L, p_value.operator PackedVector3Array());
+			break;
+		case Variant::ARRAY: {
+			Array array = p_value;
+			lua_createtable(L, array.size(), 0);
+			for (int i = 0; i < array.size(); i++) {
+				push_worker_variant(L, array[i]);
+				lua_rawseti(L, -2, i + 1);
+			}
+		} break;
+		case Variant::DICTIONARY: {
+			Dictionary dict = p_value;
+			lua_createtable(L, 0, dict.size());
+			for (const Variant *key = dict.next(nullptr); key; key = dict.next(key)) {
+				push_worker_variant(L, *key);
+				push_worker_variant(L, dict[*key]);
+				lua_rawset(L, -3);
+			}
+		} break;
+		default:
+			lua_pushnil(L);
+			break;
+	}
+}
+
+static int worker_print(lua_State *L) {
+	String str;
+	int n = lua_gettop(L);
+	for (int i = 1; i <= n; i++) {
+		if (i > 1) {
+			str += "\t";
+		}
+		str += String::utf8(luaL_tolstring(L, i, nullptr));
+		lua_pop(L, 1);
+	}
+	print_line(str);
+	return 0;
+}
+
+static int worker_message_handler(lua_State *L) {
+	luaL_traceback(L, L, lua_tostring(L, 1), 1);
+	return 1;
+}
+
+// Worker states only have the Lua libraries and the value types: nothing in them may touch objects.
+static lua_State *acquire_worker_state() {
+	{
+		MutexLock lock(workers_mutex);
+		if (idle_states.size()) {
+			lua_State *L = idle_states[idle_states.size() - 1];
+			idle_states.resize(idle_states.size() - 1);
+			return L;
+		}
+	}
+	lua_State *L = luaL_newstate();
+	lua_atpanic(L, &godot_lua_atpanic);
+	luaL_openlibs(L);
+	lua_register(L, "print", &worker_print);
+	register_godot_value_types(L);
+	register_godot_packed_arrays(L);
+	return L;
+}
+
+static void release_worker_state(lua_State *L) {
+	lua_settop(L, 0);
+	MutexLock lock(workers_mutex);
+	idle_states.push_back(L);
+}
+
+// Pushes `module[function]`, loading the module the first time this state runs an input of the job.
+static bool push_worker_function(lua_State *L, const LuaWorkerJob *p_job, String &r_error) {
+	lua_rawgetp(L, LUA_REGISTRYINDEX, &worker_module_job_key);
+	bool loaded = lua_tointeger(L, -1) == (lua_Integer)p_job->id;
+	lua_pop(L, 1);
+	if (loaded) {
+		lua_rawgetp(L, LUA_REGISTRYINDEX, &worker_module_key); // module
+	} else {
+		const char *chunk = (const char *)p_job->chunk.ptr();
+		if (luaL_loadbufferx(L, chunk, p_job->chunk.size(), p_job->path.get_data(), "b") != LUA_OK) {
+			r_error = String::utf8(lua_tostring(L, -1));
+			return false;
+		}
+		// Globals the module sets stay in its own environment, they don't leak into the next job.
+		lua_newtable(L); // chunk|env
+		lua_createtable(L, 0, 1);
+		lua_pushglobaltable(L);
+		lua_setfield(L, -2, "__index");
+		lua_setmetatable(L, -2);
+		lua_setupvalue(L, -2, 1); // chunk
+		if (lua_pcall(L, 0, 1, 0) != LUA_OK) {
+			r_error = String::utf8(lua_tostring(L, -1));
+			return false;
+		}
+		if (!lua_istable(L, -1)) {
+			r_error = vformat("'%s' doesn't return a table", p_job->path.get_data());
+			return false;
+		}
+		lua_pushvalue(L, -1);
+		lua_rawsetp(L, LUA_REGISTRYINDEX, &worker_module_key); // module
+		lua_pushinteger(L, p_job->id);
+		lua_rawsetp(L, LUA_REGISTRYINDEX, &worker_module_job_key);
+	}
+	lua_getfield(L, -1, p_job->function.get_data());
+	if (!lua_isfunction(L, -1)) {
+		r_error = vformat("'%s' has no function '%s'", p_job->path.get_data(), p_job->function.get_data());
+		return false;
+	}
+	return true;
+}
+
+// Called protected with the job and the input index: the module lookup and the input conversion raise Lua errors too.
+// Returns the result, or nil and the reason the function could not be found.
+static int worker_job_call(lua_State *L) {
+	auto job = static_cast<const LuaWorkerJob *>(lua_touserdata(L, 1));
+	uint32_t index = uint32_t(lua_tointeger(L, 2));
+	lua_settop(L, 0);
+	{
+		String error;
+		if (!push_worker_function(L, job, error)) {
+			lua_pushnil(L);
+			lua_pushstring(L, GD_UTF8_STR(error));
+			return 2;
+		}
+	}
+	push_worker_variant(L, job->inputs[index]);
+	lua_call(L, 1, 1);
+	return 1;
+}
+
+static void run_worker_job(void *p_userdata, uint32_t p_index) {
+	LuaWorkerJob *job = static_cast<LuaWorkerJob *>(p_userdata);
+	lua_State *L = acquire_worker_state();
+	lua_pushcfunction(L, &worker_message_handler);
+	lua_pushcfunction(L, &worker_job_call);
+	lua_pushlightuserdata(L, job);
+	lua_pushinteger(L, p_index);
+	String error;
+	if (lua_pcall(L, 2, 2, 1) != LUA_OK || lua_type(L, -1) == LUA_TSTRING) {
+		error = String::utf8(lua_tostring(L, -1));
+	} else {
+		to_worker_variant(L, -2, job->results[p_index], 0, error);
+	}
+	job->errors[p_index] = error;
+	release_worker_state(L);
+}
+
+static void wait_worker_job(LuaWorkerJob *p_job) {
+	if (!p_job->waited) {
+		p_job->waited = true;
+		if (p_job->group >= 0) {
+			WorkerThreadPool::get_singleton()->wait_for_group_task_completion(p_job->group);
+		}
+	}
+}
+
+_FORCE_INLINE_ static LuaWorkerJob *check_worker_job(lua_State *L, int pos) {
+	return static_cast<LuaWorkerJob *>(luaL_checkudata(L, pos, LUA_WORKER_JOB));
+}
+
+/**
+ * @brief `LuaWorkers.run(path, function, inputs)` calls `function` of the module at `path` with each input, in parallel.
+ * Returns the job, whose `wait()` returns the results and a table of errors (nil if none).
+ */
+static int lua_workers_run(lua_State *L) {
+	const char *path = luaL_checkstring(L, 1);
+	const char *function = luaL_checkstring(L, 2);
+	luaL_checktype(L, 3, LUA_TTABLE);
+
+	String res_path = String::utf8(path);
+	Vector<uint8_t> *chunk = worker_chunks.getptr(res_path);
+	if (chunk == nullptr) {
+		Vector<uint8_t> compiled;
+		if (LuaScriptLanguage::load_chunk(L, res_path, compiled) != OK) {
+			return luaL_error(L, "cannot load Lua worker module '%s'", path);
+		}
+		chunk = &worker_chunks.insert(res_path, compiled)->value;
+	}
+
+	auto job = static_cast<LuaWorkerJob *>(lua_newuserdatauv(L, sizeof(LuaWorkerJob), 0));
+	memnew_placement(job, LuaWorkerJob);
+	luaL_setmetatable(L, LUA_WORKER_JOB);
+	job->id = ++last_worker_job_id;
+	job->chunk = *chunk;
+	job->path = path;
+	job->function = function;
+
+	uint32_t count = lua_rawlen(L, 3);
+	job->inputs.resize(count);
+	job->results.resize(count);
+	job->errors.resize(count);
+	bool valid = true;
+	{
+		String error;
+		for (uint32_t i = 0; i < count && valid; i++) {
+			lua_rawgeti(L, 3, i + 1);
+			valid = to_worker_variant(L, -1, job->inputs[i], 0, error);
+			lua_pop(L, 1);
+			if (!valid) {
+				lua_pushfstring(L, "input %d: %s", i + 1, GD_UTF8_STR(error));
+			}
+		}
+	}
+	if (!valid) {
+		return lua_error(L);
+	}
+
+	if (count > 0) {
+		job->group = WorkerThreadPool::get_singleton()->add_native_group_task(&run_worker_job, job, count, -1, false, "LuaWorkers.run");
+	}
+	return 1;
+}
+
+static int lua_worker_job_wait(lua_State *L) {
+	LuaWorkerJob *job = check_worker_job(L, 1);
+	wait_worker_job(job);
+
+	lua_createtable(L, job->results.size(), 0);
+	int errors = 0;
+	for (uint32_t i = 0; i < job->results.size(); i++) {
+		LuaScriptLanguage::push_variant(L, &job->results[i]);
+		lua_rawseti(L, -2, i + 1);
+		if (!IS_EMPTY(job->errors[i])) {
+			if (errors++ == 0) {
+				lua_newtable(L);
+			}
+			lua_pushstring(L, GD_UTF8_STR(job->errors[i]));
+			lua_rawseti(L, -2, i + 1);
+		}
+	}
+	if (errors == 0) {
+		lua_pushnil(L);
+	}
+	return 2;
+}
+
+static int lua_worker_job_is_done(lua_State *L) {
+	LuaWorkerJob *job = check_worker_job(L, 1);
+	lua_pushboolean(L, job->waited || job->group < 0 || WorkerThreadPool::get_singleton()->is_group_task_completed(job->group));
+	return 1;
+}
+
+static int lua_worker_job_gc(lua_State *L) {
+	LuaWorkerJob *job = check_worker_job(L, 1);
+	// Workers still write into the job until it completes.
+	wait_worker_job(job);
+	job->~LuaWorkerJob();
+	return 0;
+}
+#endif
+
+extern void register_lua_workers(lua_State *L) {
+#ifndef GODOT_3_X
+	luaL_newmetatable(L, LUA_WORKER_JOB);
+	lua_pushvalue(L, -1);
+	lua_setfield(L, -2, "__index");
+	luatable_rawset(L, -1, "wait", &lua_worker_job_wait);
+	luatable_rawset(L, -1, "is_done", &lua_worker_job_is_done);
+	luatable_rawset(L, -1, "__gc", &lua_worker_job_gc);
+	lua_pop(L, 1);
+
+	lua_newtable(L);
+	luatable_rawset(L, -1, "run", &lua_workers_run);
+	lua_setglobal(L, "LuaWorkers");
+#endif
+}
+
+// The chunk of a module is compiled again on the next job once its script reloads.
+extern void reload_lua_worker_module(const String &p_path) {
+#ifndef GODOT_3_X
+	worker_chunks.erase(p_path);
+#endif
+}
+
+extern void finish_lua_workers() {
+#ifndef GODOT_3_X
+	MutexLock lock(workers_mutex);
+	for (uint32_t i = 0; i < idle_states.size(); i++) {
+		lua_close(idle_states[i]);
+	}
+	idle_states.clear();
+	worker_chunks.clear();
+#endif
+}
@@ -6,6 +6,192 @@
 #include "constants.h"
 #include "godot_lua_convert_api.h"
 #include "luascript_language.h"
+#ifndef GODOT_3_X
+#include "core/variant/variant_internal.h"
+#endif
+
+#ifndef GODOT_3_X
+#define LUA_VARIANT_CALL "GodotVariantCall"
+#define LUA_VARIANT_CALL_MAX_ARGS 8
+
+/**
+ * @brief A utility function or builtin method resolved once, held by the closure calling it as its upvalue.
+ * Calls matching its signature go through the validated pointer, others through the name.
+ */
+struct LuaVariantCall {
+	StringName name;
+	Variant::Type base_type = Variant::NIL;
+	Variant::ValidatedUtilityFunction utility = nullptr;
+	Variant::ValidatedBuiltInMethod method = nullptr;
+	Variant::Type return_type = Variant::NIL;
+	bool vararg = false;
+	int argcount = 0;
+	Variant::Type arg_types[LUA_VARIANT_CALL_MAX_ARGS];
+};
+
+static int variant_call_gc(lua_State *L) {
+	static_cast<LuaVariantCall *>(lua_touserdata(L, 1))->~LuaVariantCall();
+	return 0;
+}
+
+static LuaVariantCall *new_variant_call(lua_State *L, const StringName &p_name) {
+	auto call = static_cast<LuaVariantCall *>(lua_newuserdatauv(L, sizeof(LuaVariantCall), 0));
+	memnew_placement(call, LuaVariantCall);
+	call->name = p_name;
+	if (luaL_newmetatable(L, LUA_VARIANT_CALL)) {
+		luatable_rawset(L, -1, "__gc", &variant_call_gc);
+	}
+	lua_setmetatable(L, -2);
+	return call;
+}
+
+// Validated calls take arguments of the exact type, numbers are unpacked directly, anything else converted like Godot would.
+static bool to_typed_argument(lua_State *L, int pos, Variant::Type p_type, Variant &r_arg) {
+	if (lua_type(L, pos) == LUA_TNUMBER) {
+		if (p_type == Variant::FLOAT) {
+			r_arg = lua_tonumber(L, pos);
+			return true;
+		}
+		if (p_type == Variant::INT && lua_isinteger(L, pos)) {
+			r_arg = (int64_t)lua_tointeger(L, pos);
+			return true;
+		}
+	}
+	r_arg = lua_to_godot_variant(L, pos);
+	if (p_type == Variant::NIL || r_arg.get_type() == p_type) {
+		return true;
+	}
+	if (!Variant::can_convert_strict(r_arg.get_type(), p_type)) {
+		return false;
+	}
+	const Variant *arg = &r_arg;
+	Callable::CallError error;
+	Variant converted;
+	Variant::construct(p_type, converted, &arg, 1, error);
+	r_arg = converted;
+	return error.error == Callable::CallError::CALL_OK;
+}
+
+// Arguments from `p_from` to the top, typed for the validated call. False if it has to go through the name.
+static bool to_typed_arguments(lua_State *L, int p_from, const LuaVariantCall *p_call, Variant *r_args, const Variant **r_argptrs, int &r_argcount) {
+	r_argcount = lua_gettop(L) + 1 - p_from;
+	if (r_argcount > LUA_VARIANT_CALL_MAX_ARGS || (!p_call->vararg && r_argcount != p_call->argcount)) {
+		return false;
+	}
+	for (int i = 0; i < r_argcount; i++) {
+		if (!to_typed_argument(L, p_from + i, p_call->vararg ? Variant::NIL : p_call->arg_types[i], r_args[i])) {
+			return false;
+		}
+		r_argptrs[i] = &r_args[i];
+	}
+	return true;
+}
+
+static void to_arguments(lua_State *L, int p_from, Variant *r_args, const Variant **r_argptrs, int &r_argcount) {
+	r_argcount = MIN(lua_gettop(L) + 1 - p_from, LUA_VARIANT_CALL_MAX_ARGS);
+	for (int i = 0; i < r_argcount; i++) {
+		r_args[i] = lua_to_godot_variant(L, p_from + i);
+		r_argptrs[i] = &r_args[i];
+	}
+}
+
+static int utility_function_call(lua_State *L) {
+	auto call = static_cast<const LuaVariantCall *>(lua_touserdata(L, lua_upvalueindex(1)));
+	Variant args[LUA_VARIANT_CALL_MAX_ARGS];
+	const Variant *argptrs[LUA_VARIANT_CALL_MAX_ARGS] = {};
+	int argcount;
+	Variant ret;
+	if (to_typed_arguments(L, 1, call, args, argptrs, argcount)) {
+		VariantInternal::initialize(&ret, call->return_type);
+		call->utility(&ret, argptrs, argcount);
+	} else {
+		to_arguments(L, 1, args, argptrs, argcount);
+		CALL_ERROR error;
+		Variant::call_utility_function(call->name, &ret, argptrs, argcount, error);
+		if (error.error != CALL_ERROR::CALL_OK) {
+			ELog("call_utility_function error: %d", error.error);
+		}
+	}
+	LuaScriptLanguage::push_variant(L, &ret);
+	return 1;
+}
+
+static int builtin_method_call(lua_State *L) {
+	auto call = static_cast<const LuaVariantCall *>(lua_touserdata(L, lua_upvalueindex(1)));
+	// The boxed Variant is called in place, so that mutating methods stick.
+	Variant self;
+	Variant *base = &self;
+	if (LuaScriptLanguage::get_type_tag(L, 1) == LUA_TAG_VARIANT) {
+		base = static_cast<Variant *>(lua_touserdata(L, 1));
+	} else {
+		self = lua_to_godot_variant(L, 1);
+	}
+
+	Variant args[LUA_VARIANT_CALL_MAX_ARGS];
+	const Variant *argptrs[LUA_VARIANT_CALL_MAX_ARGS] = {};
+	int argcount;
+	Variant ret;
+	if (base->get_type() == call->base_type && to_typed_arguments(L, 2, call, args, argptrs, argcount)) {
+		VariantInternal::initialize(&ret, call->return_type);
+		call->method(base, argptrs, argcount, &ret);
+	} else {
+		to_arguments(L, 2, args, argptrs, argcount);
+		CALL_ERROR error;
+		base->callp(call->name, argptrs, argcount, ret, error);
+	}
+	LuaScriptLanguage::push_variant(L, &ret);
+	return 1;
+}
+#endif
+
+bool lua_push_utility_function(lua_State *L, const char *p_name) {
+#ifndef GODOT_3_X
+	StringName name(p_name);
+	if (!Variant::has_utility_function(name)) {
+		return false;
+	}
+	LuaVariantCall *call = new_variant_call(L, name);
+	call->utility = Variant::get_validated_utility_function(name);
+	call->vararg = Variant::is_utility_function_vararg(name);
+	call->argcount = Variant::get_utility_function_argument_count(name);
+	for (int i = 0; i < MIN(call->argcount, LUA_VARIANT_CALL_MAX_ARGS); i++) {
+		call->arg_types[i] = Variant::get_utility_function_argument_type(name, i);
+	}
+	if (Variant::has_utility_function_return_value(name)) {
+		call->return_type = Variant::get_utility_function_return_type(name);
+	}
+	lua_pushcclosure(L, &utility_function_call, 1);
+	return true;
+#else
+	return false;
+#endif
+}
+
+bool lua_push_builtin_method(lua_State *L, Variant::Type p_type, const char *p_name) {
+#ifndef GODOT_3_X
+	StringName name(p_name);
+	if (!Variant::has_builtin_method(p_type, name) || Variant::is_builtin_method_static(p_type, name)) {
+		return false;
+	}
+	LuaVariantCall *call = new_variant_call(L, name);
+	call->base_type = p_type;
+	call->method = Variant::get_validated_builtin_method(p_type, name);
+	call->vararg = Variant::is_builtin_method_vararg(p_type, name);
+	call->argcount = Variant::get_builtin_method_argument_count(p_type, name);
+	for (int i = 0; i < MIN(call->argcount, LUA_VARIANT_CALL_MAX_ARGS); i++) {
+		call->arg_types[i] = Variant::get_builtin_method_argument_type(p_type, name, i);
+	}
+	if (Variant::has_builtin_method_return_value(p_type, name)) {
+		call->return_type = Variant::get_builtin_method_return_type(p_type, name);
+	}
+	lua_pushcclosure(L, &builtin_method_call, 1);
+	return true;
+#else
+	return false;
+#endif
+}
+
+static char method_cache_key = 0;
 
 int lua_godot_variant_gc(lua_State *L) {
 	gdlua_tovariant(L, 1, var);
@@ -36,6 +222,26 @@ int lua_godot_variant_indexer(lua_State *L) {
 		int ktype = lua_type(L, 2);
 		if (ktype == LUA_TSTRING) {
 			auto method = lua_tostring(L, 2);
+			// Methods are resolved once per type, then found in a cache held by the metatable.
+			lua_getmetatable(L, 1); // v|k|mt
+			if (lua_rawgetp(L, -1, &method_cache_key) == LUA_TNIL) { // v|k|mt|cache
+				lua_pop(L, 1);
+				lua_newtable(L);
+				lua_pushvalue(L, -1);
+				lua_rawsetp(L, -3, &method_cache_key);
+			}
+			lua_pushvalue(L, 2);
+			if (lua_rawget(L, -2) != LUA_TNIL) {
+				return 1;
+			}
+			lua_pop(L, 1);
+			if (lua_push_builtin_method(L, var->get_type(), method)) { // v|k|mt|cache|f
+				lua_pushvalue(L, 2);
+				lua_pushvalue(L, -2);
+				lua_rawset(L, -4);
+				return 1;
+			}
+			lua_pop(L, 2);
 			if (var->has_method(method)) {
 				push_not_lua_method(L, method);
 				return 1;
@@ -11,12 +11,16 @@
 #include "luascript_instance.h"
 #include "luascript_language.h"
 
+extern void reload_lua_worker_module(const String &p_path);
+
 #define SCRIPT_SOURCE "script/source"
 
 LuaScript::LuaScript() :
 		valid(false),
 		self(this),
-		_owner(nullptr) {
+		_owner(nullptr),
+		member_cache_version(0),
+		node_path_exports_version(0) {
 #ifdef TOOLS_ENABLED
 	source_changed_cache = false;
 	placeholder_fallback_enabled = false;
@@ -29,6 +33,9 @@ LuaScript::LuaScript() :
 LuaScript::~LuaScript() {
 	// LOCK_LUA_SCRIPT
 	LuaScriptLanguage::get_singleton()->script_list.remove(&this->self);
+	if (LUA_STATE) {
+		_clear_member_cache(LUA_STATE);
+	}
 #ifndef GODOT_3_X
 	LuaScriptLanguage::remove_cache_script(get_path());
 #endif
@@ -204,6 +211,10 @@ Error LuaScript::reload(bool p_keep_state) {
 	}
 
 	this->valid = false;
+	reload_lua_worker_module(script_path);
+
+	// Functions may be replaced and inherited members change with any script, not only this one.
+	LuaScriptLanguage::get_singleton()->member_cache_version++;
 
 	lua_State *L = LUA_STATE;
 	Error ret;
@@ -235,12 +246,15 @@ Error LuaScript::reload(bool p_keep_state) {
 }
 
 bool LuaScript::has_method(const StringName &p_method) const {
-	bool ret = false;
 	lua_State *L = LUA_STATE;
-	ret = _push_script_member(L, p_method, MemberFlags::FUNCTION);
-	if (ret) {
-		ret = lua_isfunction(L, -1);
-		lua_pop(L, 1);
+	MemberKind kind = _get_member_cache(L, p_method).kind;
+	bool ret = kind == MEMBER_FUNCTION;
+	if (kind == MEMBER_DYNAMIC) {
+		ret = _push_script_member(L, p_method, MemberFlags::FUNCTION);
+		if (ret) {
+			ret = lua_isfunction(L, -1);
+			lua_pop(L, 1);
+		}
 	}
 	if (!ret) {
 		Ref<Script> base_script = get_base_script();
@@ -671,6 +685,73 @@ bool LuaScript::_push_script_member(lua_State *L, const StringName &p_name, Memb
 	return r_valid;
 }
 
+const Vector<StringName> &LuaScript::_get_node_path_exports(const LuaScriptInstance *p_instance) const {
+	uint32_t version = LuaScriptLanguage::get_singleton()->member_cache_version;
+	if (node_path_exports_version != version) {
+		node_path_exports_version = version;
+		node_path_exports.clear();
+
+		List<PropertyInfo> props;
+		_get_script_property_list(p_instance, &props);
+		for (auto E = props.front(); E; E = E->next()) {
+			if (E->get().type == Variant::NODE_PATH) {
+				node_path_exports.push_back(E->get().name);
+			}
+		}
+	}
+	return node_path_exports;
+}
+
+LuaScript::MemberCacheEntry LuaScript::_get_member_cache(lua_State *L, const StringName &p_name, const LuaScriptInstance *p_instance) const {
+	uint32_t version = LuaScriptLanguage::get_singleton()->member_cache_version;
+	if (member_cache_version != version) {
+		_clear_member_cache(L);
+		member_cache_version = version;
+	}
+
+	const MemberCacheEntry *cached = member_cache.getptr(p_name);
+	if (cached) {
+		return *cached;
+	}
+
+	MemberCacheEntry entry;
+	if (!valid) {
+		return entry;
+	}
+
+	int top = lua_gettop(L);
+	GD_STR_HOLD(field, p_name);
+	LuaScriptLanguage::push_luascript_api(L, "resolve_script_member");
+	push_self(L);
+	if (p_instance) {
+		p_instance->push_self(L);
+	} else {
+		lua_pushnil(L);
+	}
+	lua_pushstring(L, field);
+	if (godot_lua_xpcall(L, 3, 2) == LUA_OK) {
+		entry.kind = MemberKind(lua_tointeger(L, -2));
+		if (entry.kind == MEMBER_FUNCTION || entry.kind == MEMBER_PROPERTY) {
+			entry.value = luaL_ref(L, LUA_REGISTRYINDEX);
+		}
+	}
+	lua_settop(L, top);
+
+	lua_pushstring(L, field);
+	entry.key = luaL_ref(L, LUA_REGISTRYINDEX);
+	member_cache.insert(p_name, entry);
+	return entry;
+}
+
+void LuaScript::_clear_member_cache(lua_State *L) const {
+	for (auto E = ITER_BEGIN(member_cache); E; ITER_NEXT(E)) {
+		const MemberCacheEntry &entry = ITER_GET(E);
+		luaL_unref(L, LUA_REGISTRYINDEX, entry.key);
+		luaL_unref(L, LUA_REGISTRYINDEX, entry.value);
+	}
+	member_cache.clear();
+}
+
 #ifdef GODOT_3_X
 Variant LuaScript::call(const StringName &p_method, const Variant **p_args, int p_argcount, CALL_ERROR &r_error) {
 #else
@@ -17,6 +17,8 @@
 #endif
 #include "luascript_language.h"
 
+class LuaScriptInstance;
+
 class LuaScript : public Script {
 	GDCLASS(LuaScript, Script)
 
@@ -30,6 +32,22 @@ public:
 		MEMBER = 3,
 	};
 
+	/**
+	 * @brief What a member name resolves to in the script chain, see `_get_member_cache`
+	 */
+	enum MemberKind {
+		MEMBER_NONE = 0, // Not a script member, lookups can go on with the native class
+		MEMBER_FUNCTION = 1,
+		MEMBER_PROPERTY = 2,
+		MEMBER_DYNAMIC = 3, // Signals, plain fields, `super` or scripts with `_get`: resolved on every access
+	};
+
+	struct MemberCacheEntry {
+		MemberKind kind = MEMBER_DYNAMIC;
+		int key = LUA_NOREF; // Registry ref of the member name as a lua string
+		int value = LUA_NOREF; // Registry ref of the script table holding the function, or of the property info table
+	};
+
 private:
 	bool valid;
 
@@ -51,6 +69,18 @@ private:
 	 */
 	String neasted_path;
 
+	/**
+	 * @brief Resolved members by name, dropped when any script reloads
+	 */
+	mutable Map<StringName, MemberCacheEntry> member_cache;
+	mutable uint32_t member_cache_version;
+
+	/**
+	 * @brief Exported NodePath properties, turned into nodes before `_ready`. Rebuilt with the member cache
+	 */
+	mutable Vector<StringName> node_path_exports;
+	mutable uint32_t node_path_exports_version;
+
 #ifdef TOOLS_ENABLED
 	bool source_changed_cache;
 	bool placeholder_fallback_enabled;
@@ -189,6 +219,9 @@ protected:
 	void _get_property_list(List<PropertyInfo> *p_list) const;
 	void _get_script_property_list(const ScriptInstance *instance, List<PropertyInfo> *p_list) const;
 	bool _push_script_member(lua_State *L, const StringName &p_name, MemberFlags flags) const;
+	MemberCacheEntry _get_member_cache(lua_State *L, const StringName &p_name, const LuaScriptInstance *p_instance = nullptr) const;
+	void _clear_member_cache(lua_State *L) const;
+	const Vector<StringName> &_get_node_path_exports(const LuaScriptInstance *p_instance) const;
 #ifdef GODOT_3_X
 	virtual Variant call(const StringName &p_method, const Variant **p_args, int p_argcount, CALL_ERROR &r_error) override;
 #else
@@ -0,0 +1,494 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ *
+ */
+
+#include "luascript_benchmark.h"
+
+#ifdef TOOLS_ENABLED
+
+#include "godot_lua_convert_api.h"
+#include "luascript_language.h"
+#include "core/os/os.h"
+#include INC_DIR_ACCESS
+#include INC_FILE_ACCESS
+#include "scene/2d/node_2d.h"
+#ifdef GODOT_3_X
+#include "scene/main/viewport.h"
+#else
+#include "core/object/worker_thread_pool.h"
+#include "scene/main/window.h"
+#endif
+
+#define LUA_BENCHMARK_DEFAULT_ITERATIONS 100000
+#define LUA_BENCHMARK_PATH "res://__lua_benchmark__.lua"
+#define LUA_BENCHMARK_ENEMY_PATH "res://__lua_benchmark_enemy__.lua"
+#define LUA_BENCHMARK_SCENE_SIZE 1000
+#define LUA_BENCHMARK_GRID_SIZE 100
+#define LUA_BENCHMARK_MODULES 1000
+#define LUA_BENCHMARK_MODULE_FUNCTIONS 20
+#define LUA_BENCHMARK_MODULE_DIR "user://__lua_benchmark_modules__"
+#define LUA_BENCHMARK_WORKER_PATH "user://__lua_benchmark_worker__.lua"
+#define LUA_BENCHMARK_WORKER_INPUTS 64
+#define LUA_BENCHMARK_WORKER_STEPS 100000
+
+// Every case loops in Lua, so the cost of the one `call` that starts it is spread over the iterations.
+static const char *benchmark_source = R"(
+local Bench = class(Node2D)
+Bench.speed = export(1.0)
+
+function Bench:add(a, b) return a + b end
+
+function Bench:empty_loop(n) for i = 1, n do end end
+function Bench:script_property(n) local v for i = 1, n do v = self.speed end end
+function Bench:native_method_lookup(n) local v for i = 1, n do v = self.get_child_count end end
+function Bench:native_method_call(n) for i = 1, n do self:get_child_count() end end
+function Bench:native_property(n) local v for i = 1, n do v = self.name end end
+function Bench:child_node(n) local v for i = 1, n do v = self.Child end end
+function Bench:push_object(n) local v for i = 1, n do v = self:get_parent() end end
+function Bench:return_variant(n) local v for i = 1, n do v = self:get_transform() end end
+function Bench:utility_function(n) local v for i = 1, n do v = godot.lerp(1.0, 2.0, 0.5) end end
+
+return Bench
+)";
+
+// Spawned by the thousand, with exported node paths resolved before `_ready`.
+static const char *benchmark_enemy_source = R"(
+local Enemy = class(Node2D)
+Enemy.hp = export(100)
+Enemy.speed = export(4.5)
+Enemy.label = export("enemy")
+Enemy.target = export(Node)
+Enemy.weapon = export(Node)
+
+function Enemy:_ready() end
+
+return Enemy
+)";
+
+// A CPU bound function for `LuaWorkers.run`, called with LUA_BENCHMARK_WORKER_STEPS.
+static const char *benchmark_worker_source = R"(
+local Solver = {}
+
+function Solver.solve(n)
+	local sum = 0
+	for i = 1, n do sum = sum + math.sqrt(i) * math.sin(i) end
+	return sum
+end
+
+return Solver
+)";
+
+// A script of a few exports and `LUA_BENCHMARK_MODULE_FUNCTIONS` small methods, loaded by the thousand in the cold start cases.
+static String benchmark_module_source(int p_index) {
+	String source = "local Module = class(Node)\n";
+	source += vformat("Module.id = export(%d)\nModule.label = export(\"module_%d\")\n\n", p_index, p_index);
+	for (int i = 0; i < LUA_BENCHMARK_MODULE_FUNCTIONS; i++) {
+		source += vformat("function Module:method_%d(a, b)\n\tlocal v = a * %d + b\n\tif v > self.id then return v - self.id end\n\treturn v\nend\n\n", i, i + 1);
+	}
+	return source + "return Module\n";
+}
+
+// The dispatch type tags replaced: the `__name` metafield, then a lookup in the StringName keyed converter maps.
+static Variant benchmark_convert_by_name(lua_State *L, int pos) {
+	if (luaL_getmetafield(L, pos, "__name") == LUA_TNIL) {
+		return lua_to_godot_variant(L, pos);
+	}
+	StringName type_name = lua_tostring(L, -1);
+	lua_pop(L, 1);
+	if (lua_type(L, pos) == LUA_TTABLE) {
+		auto converter = LuaScriptLanguage::find_lua2godot(type_name);
+		return converter ? converter(L, pos) : Variant(lua_to_godot_object(L, pos));
+	}
+	auto converter = LuaScriptLanguage::find_udata2var(type_name);
+	return converter ? converter(lua_touserdata(L, pos)) : lua_to_godot_variant(L, pos);
+}
+
+int LuaScriptBenchmark::get_requested_iterations() {
+	List<String> args = OS::get_singleton()->get_cmdline_args();
+	for (const List<String>::Element *E = args.front(); E; E = E->next()) {
+		const String &arg = E->get();
+		if (arg == LUA_BENCHMARK_ARG) {
+			return LUA_BENCHMARK_DEFAULT_ITERATIONS;
+		}
+		if (arg.begins_with(LUA_BENCHMARK_ARG "=")) {
+			int iterations = arg.get_slice("=", 1).to_int();
+			return iterations > 0 ? iterations : LUA_BENCHMARK_DEFAULT_ITERATIONS;
+		}
+	}
+	return 0;
+}
+
+void LuaScriptBenchmark::_setup_fixture() {
+	REF_INSTANTIATE(script);
+	script->set_script_path(LUA_BENCHMARK_PATH);
+	script->set_source_code(benchmark_source);
+	script->reload();
+	ERR_FAIL_COND_MSG(!script->is_valid(), "Lua benchmark script failed to compile.");
+
+	REF_INSTANTIATE(enemy_script);
+	enemy_script->set_script_path(LUA_BENCHMARK_ENEMY_PATH);
+	enemy_script->set_source_code(benchmark_enemy_source);
+	enemy_script->reload();
+	ERR_FAIL_COND_MSG(!enemy_script->is_valid(), "Lua benchmark script failed to compile.");
+
+	// A grid map of LUA_BENCHMARK_GRID_SIZE^2 = 10k cells.
+	for (int y = 0; y < LUA_BENCHMARK_GRID_SIZE; y++) {
+		for (int x = 0; x < LUA_BENCHMARK_GRID_SIZE; x++) {
+#ifdef GODOT_3_X
+			grid[Vector2(x, y)] = x + y;
+#else
+			grid[Vector2i(x, y)] = x + y;
+#endif
+		}
+	}
+
+	Node *holder = memnew(Node);
+	holder->set_name("LuaBenchmark");
+	get_root()->add_child(holder);
+
+	fixture = memnew(Node2D);
+	fixture->set_name("Fixture");
+	Node *child = memnew(Node);
+	child->set_name("Child");
+	fixture->add_child(child);
+#ifdef GODOT_3_X
+	fixture->set_script(script.get_ref_ptr());
+#else
+	fixture->set_script(script);
+#endif
+	holder->add_child(fixture);
+}
+
+void LuaScriptBenchmark::_report(const char *p_name, uint64_t p_usec, int p_count) {
+	double ns = p_usec * 1000.0 / p_count;
+	print_line(vformat("%s%s ns/op", String(p_name).rpad(32), String::num(ns, 1).lpad(10)));
+}
+
+bool LuaScriptBenchmark::_write_file(const String &p_path, const uint8_t *p_data, int p_size) {
+	Error error;
+	FileAccessRef file = FileAccess::open(p_path, FileAccess::WRITE, &error);
+	ERR_FAIL_COND_V_MSG(error != OK, false, vformat("Cannot write Lua benchmark file '%s'.", p_path));
+	file->store_buffer(p_data, p_size);
+	return true;
+}
+
+// Runs `p_code` and leaves its result on the stack, or prints the error and leaves nothing.
+bool LuaScriptBenchmark::_dostring(lua_State *L, const char *p_code) {
+	if (luaL_dostring(L, p_code) != LUA_OK) {
+		ERR_PRINT(vformat("Lua benchmark chunk failed: %s", lua_tostring(L, -1)));
+		lua_pop(L, 1);
+		return false;
+	}
+	return true;
+}
+
+void LuaScriptBenchmark::_run_lua_case(const char *p_name, const char *p_function) {
+	lua_gc(LUA_STATE, LUA_GCCOLLECT, 0);
+	fixture->call(p_function, MAX(iterations / 10, 1));
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	fixture->call(p_function, iterations);
+	_report(p_name, OS::get_singleton()->get_ticks_usec() - start, iterations);
+}
+
+void LuaScriptBenchmark::_run_native_case(const char *p_name, void (*p_case)(LuaScriptBenchmark *, int)) {
+	lua_gc(LUA_STATE, LUA_GCCOLLECT, 0);
+	p_case(this, MAX(iterations / 10, 1));
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	p_case(this, iterations);
+	_report(p_name, OS::get_singleton()->get_ticks_usec() - start, iterations);
+}
+
+void LuaScriptBenchmark::_call_lua_method(LuaScriptBenchmark *p_self, int p_count) {
+	StringName method = "add";
+	for (int i = 0; i < p_count; i++) {
+		p_self->fixture->call(method, i, 1);
+	}
+}
+
+void LuaScriptBenchmark::_table_to_dictionary(LuaScriptBenchmark *p_self, int p_count) {
+	lua_State *L = LUA_STATE;
+	if (!_dostring(L, "return { name = 'enemy', hp = 100, speed = 4.5, alive = true, level = 3, tag = 'boss', x = 10, y = 20 }")) {
+		return;
+	}
+	for (int i = 0; i < p_count; i++) {
+		Variant var = lua_to_godot_variant(L, -1);
+	}
+	lua_pop(L, 1);
+}
+
+void LuaScriptBenchmark::_dictionary_to_lua(LuaScriptBenchmark *p_self, int p_count) {
+	lua_State *L = LUA_STATE;
+	Dictionary dict;
+	dict["name"] = "enemy";
+	dict["hp"] = 100;
+	dict["speed"] = 4.5;
+	dict["alive"] = true;
+	Variant var = dict;
+	for (int i = 0; i < p_count; i++) {
+		LuaScriptLanguage::push_variant(L, &var);
+		lua_pop(L, 1);
+	}
+}
+
+// The 10k entry cases convert whole containers, ns/op is per entry.
+void LuaScriptBenchmark::_push_grid(LuaScriptBenchmark *p_self, int p_count, bool p_typed_keys) {
+	lua_State *L = LUA_STATE;
+	LuaScriptLanguage *language = LuaScriptLanguage::get_singleton();
+	bool typed_keys = language->typed_dictionary_keys;
+	language->typed_dictionary_keys = p_typed_keys;
+	for (int converted = 0; converted < p_count; converted += p_self->grid.size()) {
+		lua_push_godot_dictionary(L, p_self->grid);
+		lua_pop(L, 1);
+	}
+	language->typed_dictionary_keys = typed_keys;
+}
+
+void LuaScriptBenchmark::_grid_to_lua(LuaScriptBenchmark *p_self, int p_count) {
+	_push_grid(p_self, p_count, false);
+}
+
+void LuaScriptBenchmark::_grid_to_lua_typed(LuaScriptBenchmark *p_self, int p_count) {
+	_push_grid(p_self, p_count, true);
+}
+
+void LuaScriptBenchmark::_sparse_table_to_dictionary(LuaScriptBenchmark *p_self, int p_count) {
+	lua_State *L = LUA_STATE;
+	if (!_dostring(L, "local t = {} for i = 1, 10000 do t[i * 7] = i end return t")) {
+		return;
+	}
+	for (int converted = 0; converted < p_count; converted += 10000) {
+		Variant var = lua_to_godot_dictionary(L, -1);
+	}
+	lua_pop(L, 1);
+}
+
+void LuaScriptBenchmark::_push_variant_userdata(LuaScriptBenchmark *p_self, int p_count) {
+	lua_State *L = LUA_STATE;
+	Variant var = Transform2D(0.5, Vector2(1, 2));
+	for (int i = 0; i < p_count; i++) {
+		LuaScriptLanguage::push_variant(L, &var);
+		lua_pop(L, 1);
+	}
+}
+
+// The arguments of a typical call from Lua: an object, a boxed Variant and two value types, ns/op is per call of 4 arguments.
+void LuaScriptBenchmark::_push_call_arguments(LuaScriptBenchmark *p_self) {
+	lua_State *L = LUA_STATE;
+	Variant args[] = { Transform2D(0.5, Vector2(1, 2)), Vector2(3, 4), Vector3(5, 6, 7) };
+	LuaScriptLanguage::push_godot_object(L, p_self->fixture);
+	for (int i = 0; i < 3; i++) {
+		LuaScriptLanguage::push_variant(L, &args[i]);
+	}
+}
+
+void LuaScriptBenchmark::_convert_arguments(LuaScriptBenchmark *p_self, int p_count) {
+	lua_State *L = LUA_STATE;
+	_push_call_arguments(p_self);
+	int top = lua_gettop(L);
+	for (int i = 0; i < p_count; i++) {
+		for (int pos = top - 3; pos <= top; pos++) {
+			Variant var = lua_to_godot_variant(L, pos);
+		}
+	}
+	lua_settop(L, top - 4);
+}
+
+void LuaScriptBenchmark::_convert_arguments_by_name(LuaScriptBenchmark *p_self, int p_count) {
+	lua_State *L = LUA_STATE;
+	_push_call_arguments(p_self);
+	int top = lua_gettop(L);
+	for (int i = 0; i < p_count; i++) {
+		for (int pos = top - 3; pos <= top; pos++) {
+			Variant var = benchmark_convert_by_name(L, pos);
+		}
+	}
+	lua_settop(L, top - 4);
+}
+
+// Scenes of `LUA_BENCHMARK_SCENE_SIZE` enemies entering the tree, ns/op is per enemy.
+void LuaScriptBenchmark::_instantiate_ready(LuaScriptBenchmark *p_self, int p_count) {
+	for (int spawned = 0; spawned < p_count; spawned += LUA_BENCHMARK_SCENE_SIZE) {
+		Node *scene = memnew(Node);
+		for (int i = 0; i < MIN(LUA_BENCHMARK_SCENE_SIZE, p_count - spawned); i++) {
+			Node2D *enemy = memnew(Node2D);
+			Node *child = memnew(Node);
+			child->set_name("Child");
+			enemy->add_child(child);
+#ifdef GODOT_3_X
+			enemy->set_script(p_self->enemy_script.get_ref_ptr());
+#else
+			enemy->set_script(p_self->enemy_script);
+#endif
+			enemy->set("target", NodePath("Child"));
+			scene->add_child(enemy);
+		}
+		p_self->get_root()->add_child(scene);
+		p_self->get_root()->remove_child(scene);
+		memdelete(scene);
+	}
+}
+
+// Loads `LUA_BENCHMARK_MODULES` scripts never loaded before: from their source, from the bytecode next to an untouched source,
+// then from the stripped bytecode alone as in release exports. ns/op is per module.
+void LuaScriptBenchmark::_run_cold_start_cases() {
+	static const char *case_names[] = { "cold_start_1k_source", "cold_start_1k_bytecode", "cold_start_1k_bytecode_only" };
+	enum {
+		CASE_SOURCE,
+		CASE_BYTECODE,
+		CASE_BYTECODE_ONLY,
+		CASE_MAX,
+	};
+
+	lua_State *L = LUA_STATE;
+	DirAccessRef dir = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	for (int c = 0; c < CASE_MAX; c++) {
+		String base_dir = PATH_JOIN(String(LUA_BENCHMARK_MODULE_DIR), case_names[c]);
+		dir->make_dir_recursive(base_dir);
+
+		Vector<String> paths;
+		for (int i = 0; i < LUA_BENCHMARK_MODULES; i++) {
+			String path = PATH_JOIN(base_dir, vformat("module_%d.lua", i));
+			CharString source = benchmark_module_source(i).utf8();
+			// The source is written first, the bytecode header records its modification time.
+			if (c != CASE_BYTECODE_ONLY && !_write_file(path, (const uint8_t *)source.get_data(), source.length())) {
+				return;
+			}
+			if (c != CASE_SOURCE) {
+				Vector<uint8_t> bytecode;
+				if (LuaScriptLanguage::dump_bytecode(L, path, source, c == CASE_BYTECODE_ONLY, bytecode) != OK ||
+						!_write_file(path.get_basename() + ".luac", bytecode.ptr(), bytecode.size())) {
+					return;
+				}
+			}
+			paths.push_back(path);
+		}
+
+		lua_gc(L, LUA_GCCOLLECT, 0);
+		int failed = 0;
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < paths.size(); i++) {
+			failed += LuaScriptLanguage::compile_script(L, paths[i]) != OK;
+		}
+		_report(case_names[c], OS::get_singleton()->get_ticks_usec() - start, paths.size());
+		if (failed > 0) {
+			ERR_PRINT(vformat("%d Lua benchmark modules failed to load.", failed));
+		}
+
+		for (int i = 0; i < paths.size(); i++) {
+			dir->remove(paths[i]);
+			dir->remove(paths[i].get_basename() + ".luac");
+		}
+		dir->remove(base_dir);
+	}
+	dir->remove(LUA_BENCHMARK_MODULE_DIR);
+}
+
+#ifndef GODOT_3_X
+// `LUA_BENCHMARK_WORKER_INPUTS` CPU bound inputs solved one after the other on the main state, then by `LuaWorkers.run`
+// on the WorkerThreadPool, after a job warmed the worker states up. ns/op is per input.
+void LuaScriptBenchmark::_run_worker_cases() {
+	lua_State *L = LUA_STATE;
+	if (!_write_file(LUA_BENCHMARK_WORKER_PATH, (const uint8_t *)benchmark_worker_source, strlen(benchmark_worker_source))) {
+		return;
+	}
+
+	if (_dostring(L, benchmark_worker_source)) {
+		lua_getfield(L, -1, "solve");
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < LUA_BENCHMARK_WORKER_INPUTS; i++) {
+			lua_pushvalue(L, -1);
+			lua_pushinteger(L, LUA_BENCHMARK_WORKER_STEPS);
+			godot_lua_xpcall(L, 1, 0);
+		}
+		_report("workers_serial", OS::get_singleton()->get_ticks_usec() - start, LUA_BENCHMARK_WORKER_INPUTS);
+		lua_pop(L, 2);
+	}
+
+	String code = vformat("local inputs = {} for i = 1, %d do inputs[i] = %d end local results, errors = LuaWorkers.run('%s', 'solve', inputs):wait() return errors == nil",
+			LUA_BENCHMARK_WORKER_INPUTS, LUA_BENCHMARK_WORKER_STEPS, LUA_BENCHMARK_WORKER_PATH);
+	CharString run = code.utf8();
+	for (int pass = 0; pass < 2; pass++) {
+		uint64_t start = OS::get_singleton()->get_ticks_usec();
+		if (!_dostring(L, run.get_data())) {
+			break;
+		}
+		bool succeeded = lua_toboolean(L, -1);
+		lua_pop(L, 1);
+		ERR_BREAK_MSG(!succeeded, "Lua benchmark worker job failed.");
+		if (pass > 0) {
+			_report("workers_parallel", OS::get_singleton()->get_ticks_usec() - start, LUA_BENCHMARK_WORKER_INPUTS);
+		}
+	}
+	print_line(vformat("%s%s threads", String("worker_threads").rpad(32), itos(WorkerThreadPool::get_singleton()->get_thread_count()).lpad(10)));
+
+	DirAccessRef dir = DirAccess::create(DirAccess::ACCESS_USERDATA);
+	dir->remove(LUA_BENCHMARK_WORKER_PATH);
+}
+#endif
+
+#ifdef GODOT_3_X
+void LuaScriptBenchmark::init() {
+#else
+void LuaScriptBenchmark::initialize() {
+#endif
+	// The project's own scene would run its scripts alongside the cases.
+	if (Node *scene = get_current_scene()) {
+		set_current_scene(nullptr);
+		get_root()->remove_child(scene);
+		memdelete(scene);
+	}
+
+#ifdef GODOT_3_X
+	SceneTree::init();
+#else
+	SceneTree::initialize();
+#endif
+
+	iterations = get_requested_iterations();
+	if (iterations == 0) {
+		iterations = LUA_BENCHMARK_DEFAULT_ITERATIONS;
+	}
+	_setup_fixture();
+	if (fixture == nullptr) {
+		quit();
+		return;
+	}
+
+	print_line(vformat("Lua benchmark, %d iterations per case:", iterations));
+	_run_lua_case("lua_loop", "empty_loop");
+	_run_native_case("callp", &_call_lua_method);
+	_run_lua_case("index_script_property", "script_property");
+	_run_lua_case("index_native_method", "native_method_lookup");
+	_run_lua_case("call_native_method", "native_method_call");
+	_run_lua_case("index_native_property", "native_property");
+	_run_lua_case("index_child_node", "child_node");
+	_run_lua_case("push_godot_object", "push_object");
+	_run_lua_case("return_variant", "return_variant");
+#ifndef GODOT_3_X
+	_run_lua_case("utility_function", "utility_function");
+#endif
+	_run_native_case("push_variant_userdata", &_push_variant_userdata);
+	_run_native_case("convert_args", &_convert_arguments);
+	_run_native_case("convert_args_by_name", &_convert_arguments_by_name);
+	_run_native_case("table_to_dictionary", &_table_to_dictionary);
+	_run_native_case("dictionary_to_lua", &_dictionary_to_lua);
+	_run_native_case("grid_10k_to_lua", &_grid_to_lua);
+	_run_native_case("grid_10k_to_lua_typed", &_grid_to_lua_typed);
+	_run_native_case("table_10k_to_dictionary", &_sparse_table_to_dictionary);
+	_run_native_case("instantiate_ready", &_instantiate_ready);
+	_run_cold_start_cases();
+#ifndef GODOT_3_X
+	_run_worker_cases();
+#endif
+	quit();
+}
+
+LuaScriptBenchmark::LuaScriptBenchmark() :
+		fixture(nullptr),
+		iterations(LUA_BENCHMARK_DEFAULT_ITERATIONS) {
+}
+
+#endif // TOOLS_ENABLED
@@ -0,0 +1,70 @@
+/**
+ * This file is part of Lua binding for Godot Engine.
+ *
+ */
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "luascript.h"
+#include "scene/main/scene_tree.h"
+
+#define LUA_BENCHMARK_ARG "--lua-benchmark"
+
+class Node2D;
+
+/**
+ * @brief Headless benchmark of the Lua <-> Godot crossings, started with `--lua-benchmark[=<iterations>]` in editor builds.
+ * It replaces the main loop, discards the main scene, prints the ns/op of every case and quits.
+ */
+class LuaScriptBenchmark : public SceneTree {
+	GDCLASS(LuaScriptBenchmark, SceneTree)
+
+	Ref<LuaScript> script;
+	Ref<LuaScript> enemy_script;
+	Node2D *fixture;
+	Dictionary grid;
+	int iterations;
+
+	void _setup_fixture();
+	void _run_lua_case(const char *p_name, const char *p_function);
+	void _run_native_case(const char *p_name, void (*p_case)(LuaScriptBenchmark *, int));
+	void _report(const char *p_name, uint64_t p_usec, int p_count);
+
+	static bool _dostring(lua_State *L, const char *p_code);
+	static bool _write_file(const String &p_path, const uint8_t *p_data, int p_size);
+	void _run_cold_start_cases();
+#ifndef GODOT_3_X
+	void _run_worker_cases();
+#endif
+
+	static void _call_lua_method(LuaScriptBenchmark *p_self, int p_count);
+	static void _table_to_dictionary(LuaScriptBenchmark *p_self, int p_count);
+	static void _dictionary_to_lua(LuaScriptBenchmark *p_self, int p_count);
+	static void _push_grid(LuaScriptBenchmark *p_self, int p_count, bool p_typed_keys);
+	static void _grid_to_lua(LuaScriptBenchmark *p_self, int p_count);
+	static void _grid_to_lua_typed(LuaScriptBenchmark *p_self, int p_count);
+	static void _sparse_table_to_dictionary(LuaScriptBenchmark *p_self, int p_count);
+	static void _push_variant_userdata(LuaScriptBenchmark *p_self, int p_count);
+	static void _push_call_arguments(LuaScriptBenchmark *p_self);
+	static void _convert_arguments(LuaScriptBenchmark *p_self, int p_count);
+	static void _convert_arguments_by_name(LuaScriptBenchmark *p_self, int p_count);
+	static void _instantiate_ready(LuaScriptBenchmark *p_self, int p_count);
+
+public:
+	/**
+	 * @brief Iterations asked on the command line, 0 when no benchmark was requested
+	 */
+	static int get_requested_iterations();
+
+#ifdef GODOT_3_X
+	virtual void init() override;
+#else
+	virtual void initialize() override;
+#endif
+
+	LuaScriptBenchmark();
+};
+
+#endif // TOOLS_ENABLED
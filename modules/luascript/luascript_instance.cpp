@@ -53,7 +53,7 @@ bool LuaScriptInstance::_lua_set(lua_State *L, const StringName &p_name, const V
 }
 
 bool LuaScriptInstance::_lua_get(lua_State *L, const StringName &p_name, Variant &r_ret) const {
-	bool exists = _push_instance_member(L, GD_UTF8_NAME(p_name), MemberFlags::PROPERTY);
+	bool exists = _push_instance_member(L, p_name, MemberFlags::PROPERTY);
 	if (exists) {
 		r_ret = lua_to_godot_variant(L, -1);
 		lua_pop(L, 1);
@@ -131,17 +131,13 @@ Variant LuaScriptInstance::callp(const StringName &p_method, const Variant **p_a
 	Node *nd = Object::cast_to<Node>(owner);
 	if (nd != nullptr && p_method == SceneStringNames::get_singleton()->_ready) {
 		// Convert NodePath to Node
-		List<PropertyInfo> props;
-		get_property_list(&props);
-		for (auto E = props.front(); E; E = E->next()) {
-			auto info = E->get();
-			if (info.type == Variant::NODE_PATH) {
-				Variant value;
-				if (_lua_get(L, info.name, value)) {
-					Node *child = nd->get_node_or_null(value.operator NodePath());
-					if (child != nullptr) {
-						_lua_set(L, info.name, Variant(child));
-					}
+		const Vector<StringName> exports = script->_get_node_path_exports(this);
+		for (int i = 0; i < exports.size(); i++) {
+			Variant value;
+			if (_lua_get(L, exports[i], value) && value.get_type() == Variant::NODE_PATH) {
+				Node *child = nd->get_node_or_null(value.operator NodePath());
+				if (child != nullptr) {
+					_lua_set(L, exports[i], Variant(child));
 				}
 			}
 		}
@@ -150,7 +146,7 @@ Variant LuaScriptInstance::callp(const StringName &p_method, const Variant **p_a
 	lua_settop(L, top);
 	Variant var;
 
-	if (!push_method(L, GD_STR_NAME_DATA(p_method))) {
+	if (!push_method(L, p_method)) {
 		r_error.error = CALL_ERROR::CALL_ERROR_INVALID_METHOD;
 		goto EXIT;
 	}
@@ -160,6 +156,9 @@ Variant LuaScriptInstance::callp(const StringName &p_method, const Variant **p_a
 		LuaScriptLanguage::push_variant(L, p_args[i]);
 	}
 
+	if (LuaScriptLanguage::is_profiling()) {
+		LuaScriptLanguage::profile_name_next_call(p_method);
+	}
 	if (godot_lua_xpcall(L, 1 + p_argcount, 1) != LUA_OK) {
 		r_error.error = CALL_ERROR::CALL_ERROR_INVALID_ARGUMENT;
 		goto EXIT;
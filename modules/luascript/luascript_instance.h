@@ -67,7 +67,51 @@ public:
 
 	virtual ScriptLanguage *get_language() override;
 
-	bool _push_instance_member(lua_State *L, const char *field, MemberFlags flags) const {
+	bool _push_instance_member(lua_State *L, const StringName &p_name, MemberFlags flags) const {
+		auto entry = script->_get_member_cache(L, p_name, this);
+		if (entry.kind == LuaScript::MEMBER_DYNAMIC) {
+			GD_STR_HOLD(field, p_name);
+			return _push_instance_member_uncached(L, field, flags);
+		}
+
+		// Fields assigned on the instance itself shadow the script.
+		push_self(L);
+		lua_rawgeti(L, LUA_REGISTRYINDEX, entry.key);
+		if (lua_rawget(L, -2) != LUA_TNIL) {
+			lua_remove(L, -2);
+			return true;
+		}
+		lua_pop(L, 2);
+
+		switch (entry.kind) {
+			case LuaScript::MEMBER_FUNCTION: {
+				// Read from the script table, functions replaced at runtime are picked up.
+				lua_rawgeti(L, LUA_REGISTRYINDEX, entry.value);
+				lua_rawgeti(L, LUA_REGISTRYINDEX, entry.key);
+				if (lua_rawget(L, -2) == LUA_TFUNCTION) {
+					lua_remove(L, -2);
+					return true;
+				}
+				lua_pop(L, 2);
+				// No longer a function there, resolve it again.
+				LuaScriptLanguage::invalidate_member_caches();
+				GD_STR_HOLD(field, p_name);
+				return _push_instance_member_uncached(L, field, flags);
+			}
+			case LuaScript::MEMBER_PROPERTY:
+				return (flags & MemberFlags::PROPERTY) && _push_instance_property(L, entry);
+			default:
+				return false;
+		}
+	}
+	bool _push_instance_property(lua_State *L, const LuaScript::MemberCacheEntry &p_entry) const {
+		lua_rawgeti(L, LUA_REGISTRYINDEX, LuaScriptLanguage::get_singleton()->fn_get_instance_property);
+		push_self(L);
+		lua_rawgeti(L, LUA_REGISTRYINDEX, p_entry.key);
+		lua_rawgeti(L, LUA_REGISTRYINDEX, p_entry.value);
+		return godot_lua_xpcall(L, 3, 1) == LUA_OK;
+	}
+	bool _push_instance_member_uncached(lua_State *L, const char *field, MemberFlags flags) const {
 		bool exists = false;
 		LuaScriptLanguage::push_luascript_api(L, "get_instance_member");
 		push_self(L);
@@ -96,14 +140,14 @@ public:
 		return exists;
 	}
 	bool push_member(lua_State *L, const StringName &field) const {
-		return _push_instance_member(L, GD_STR_NAME_DATA(field), MemberFlags::MEMBER);
+		return _push_instance_member(L, field, MemberFlags::MEMBER);
 	}
 
 	void push_self(lua_State *L) const {
 		lua_rawgeti(L, LUA_REGISTRYINDEX, ref);
 	}
 
-	bool push_method(lua_State *L, const char *method) {
+	bool push_method(lua_State *L, const StringName &method) {
 		return _push_instance_member(L, method, MemberFlags::FUNCTION);
 	}
 
@@ -10,14 +10,17 @@
 #include "core/engine.h"
 #include "core/list.h"
 #include "core/os/dir_access.h"
+#include "core/project_settings.h"
 #else
 #include "core/config/engine.h"
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
 #include "core/string/translation.h"
 #include "core/templates/list.h"
+#include "main/performance.h"
 #endif
 #include "core/debugger/engine_debugger.h"
+#include "core/io/marshalls.h"
 #include "core/io/resource_loader.h"
 #include "core/os/os.h"
 #include "editor/editor_settings.h"
@@ -29,13 +32,20 @@
 #include "luascript_language.h"
 #include "modules/lua_templates.gen.h"
 
+#define LUA_GC_GEN_MINOR_MUL 20 // Lua's default, percent of heap growth between young collections.
+#define LUA_GC_TIME_MONITOR "LuaScript/GC Time (ms)"
+#define LUA_GC_HEAP_MONITOR "LuaScript/Heap Size (KB)"
+
 /*****************************************************************************/
 extern void init_lua_global(lua_State *L);
 extern void load_thirdlib_serpent(lua_State *L);
 extern void register_godot_userdata_types(lua_State *L);
 extern void load_godot_value_types(lua_State *L);
+extern void register_lua_workers(lua_State *L);
+extern void finish_lua_workers();
 extern void create_gdsingleton_for_lua(Object *singleton);
 extern int ref_luascript_api(lua_State *L);
+extern void reset_godot_member_tables(lua_State *L);
 
 void godot_lua_warn(void *ud, const char *msg, int tocont);
 
@@ -60,6 +70,7 @@ static void global_method_to_object(const char *g_method, const char *method) {
 }
 
 LuaScriptLanguage *LuaScriptLanguage::singleton = nullptr;
+char LuaScriptLanguage::type_tag_key = 0;
 
 LuaScriptLanguage::LuaScriptLanguage() {
 	ERR_FAIL_COND(singleton);
@@ -100,6 +111,28 @@ void LuaScriptLanguage::init() {
 	lua_newtable(L);
 	methods = luaL_ref(L, LUA_REGISTRYINDEX);
 
+	// Create a table to reuse the proxies of objects, entries go away with the proxies.
+	lua_newtable(L);
+	lua_createtable(L, 0, 1);
+	luatable_rawset(L, -1, "__mode", "v");
+	lua_setmetatable(L, -2);
+	object_proxies = luaL_ref(L, LUA_REGISTRYINDEX);
+
+	// Create a table to track coroutines, a coroutine keeps the hook of its creator even once the hook changes.
+	lua_newtable(L);
+	lua_createtable(L, 0, 1);
+	luatable_rawset(L, -1, "__mode", "k");
+	lua_setmetatable(L, -2);
+	coroutines = luaL_ref(L, LUA_REGISTRYINDEX);
+	lua_getglobal(L, "coroutine");
+	lua_getfield(L, -1, "create");
+	lua_pushcclosure(L, &godot_lua_coroutine_create, 1);
+	lua_setfield(L, -2, "create");
+	lua_getfield(L, -1, "wrap");
+	lua_pushcclosure(L, &godot_lua_coroutine_wrap, 1);
+	lua_setfield(L, -2, "wrap");
+	lua_pop(L, 1);
+
 #ifdef USE_LUA_REQUIRE
 	lua_getglobal(L, "package");
 	lua_getfield(L, -1, "searchers");
@@ -114,7 +147,10 @@ void LuaScriptLanguage::init() {
 	init_lua_global(L);
 	//register_godot_userdata_types(L);
 	load_thirdlib_serpent(L);
+	set_tag_converter(LUA_TAG_OBJECT, &lua_tagged_object_to_variant);
+	set_tag_converter(LUA_TAG_VARIANT, &lua_tagged_variant_to_variant);
 	load_godot_value_types(L);
+	register_lua_workers(L);
 
 	// Extends string methods
 	lua_getglobal(L, "string");
@@ -131,6 +167,8 @@ void LuaScriptLanguage::init() {
 #endif
 	luascript_api = ref_luascript_api(L);
 	ref_global_var("__reassign_script", fn_reassign_script);
+	push_luascript_api(L, "get_instance_property");
+	fn_get_instance_property = luaL_ref(L, LUA_REGISTRYINDEX);
 
 	singleton4lua = CLS_INSTANTIATE("Object");
 	create_gdsingleton_for_lua(singleton4lua);
@@ -139,20 +177,167 @@ void LuaScriptLanguage::init() {
 	global_method_to_object("__godot_object_connect", "connect");
 	global_method_to_object("__godot_object_disconnect", "disconnect");
 	global_method_to_object("__godot_object_is_connected", "is_connected");
+	reset_godot_member_tables(L);
 
 #ifdef GODOT_3_X
 	auto debugger = ScriptDebugger::get_singleton();
-	if (debugger && debugger->is_remote()) {
-		lua_sethook(L, &godot_lua_hook, LUA_MASKLINE | LUA_MASKCALL | LUA_MASKRET, 0);
-	}
+	debugging = debugger && debugger->is_remote();
 #else
 	auto debugger = EngineDebugger::get_singleton();
-	if (debugger && !Engine::get_singleton()->is_editor_hint()) {
-		lua_sethook(L, &godot_lua_hook, LUA_MASKLINE | LUA_MASKCALL | LUA_MASKRET, 0);
+	debugging = debugger && !Engine::get_singleton()->is_editor_hint();
+#endif
+	if (debugging) {
+		_update_breakpoints();
+	}
+	_update_hook();
+
+	gc_mode = GCMode(int(GLOBAL_GET("luascript/gc/mode")));
+	gc_frame_budget = int(GLOBAL_GET("luascript/gc/frame_budget_usec"));
+	gc_pause = GLOBAL_GET("luascript/gc/pause");
+	if (gc_mode == GC_MODE_GENERATIONAL) {
+		lua_gc(L, LUA_GCGEN, LUA_GC_GEN_MINOR_MUL, 0);
+	} else if (gc_frame_budget > 0) {
+		// `frame()` starts cycles at `gc_pause`, Lua's own collector stays on with twice the pause
+		// so a heap growing within a single frame is still collected.
+		lua_gc(L, LUA_GCINC, MIN(gc_pause * 2, 1000), 0, 0);
+	} else {
+		lua_gc(L, LUA_GCINC, gc_pause, 0, 0);
 	}
+	gc_threshold = lua_gc(L, LUA_GCCOUNT, 0) * gc_pause / 100;
+
+	typed_dictionary_keys = GLOBAL_GET("luascript/dictionary/typed_keys");
+}
+
+static ScriptDebugger *get_script_debugger() {
+#ifdef GODOT_3_X
+	return ScriptDebugger::get_singleton();
+#else
+	return EngineDebugger::get_singleton()->get_script_debugger();
 #endif
 }
 
+static void set_line_bit(LocalVector<uint64_t> &r_bits, int p_line) {
+	uint32_t word = uint32_t(p_line) >> 6;
+	if (word >= r_bits.size()) {
+		uint32_t size = r_bits.size();
+		r_bits.resize(word + 1);
+		memset(r_bits.ptr() + size, 0, (word + 1 - size) * sizeof(uint64_t));
+	}
+	r_bits[word] |= uint64_t(1) << (p_line & 63);
+}
+
+_FORCE_INLINE_ static bool has_line_bit(const LocalVector<uint64_t> &p_bits, int p_line) {
+	uint32_t word = uint32_t(p_line) >> 6;
+	return word < p_bits.size() && ((p_bits[word] >> (p_line & 63)) & 1);
+}
+
+void LuaScriptLanguage::_update_hook() {
+	int mask = 0;
+	if (debugging) {
+		if (get_script_debugger()->get_lines_left() > 0) {
+			// Stepping counts lines and follows the call depth.
+			mask |= LUA_MASKLINE | LUA_MASKCALL | LUA_MASKRET;
+		} else if (!IS_EMPTY(breakpoint_lines)) {
+			mask |= LUA_MASKLINE;
+		}
+	}
+	if (profiling) {
+		mask |= LUA_MASKCALL | LUA_MASKRET;
+	}
+	if (mask == hook_mask) {
+		return;
+	}
+	hook_mask = mask;
+	// Without a hook the VM runs at full speed, so it is removed when nothing needs it.
+	lua_sethook(state, mask ? &godot_lua_hook : nullptr, mask, 0);
+
+	lua_rawgeti(state, LUA_REGISTRYINDEX, coroutines);
+	lua_pushnil(state);
+	while (lua_next(state, -2)) {
+		lua_pop(state, 1);
+		lua_sethook(lua_tothread(state, -1), mask ? &godot_lua_hook : nullptr, mask, 0);
+	}
+	lua_pop(state, 1);
+}
+
+void LuaScriptLanguage::track_coroutine(lua_State *L, int pos) {
+	lua_State *co = lua_tothread(L, pos);
+	if (co == nullptr) {
+		return;
+	}
+	pos = lua_absindex(L, pos);
+	lua_rawgeti(L, LUA_REGISTRYINDEX, singleton->coroutines);
+	lua_pushvalue(L, pos);
+	lua_pushboolean(L, 1);
+	lua_rawset(L, -3);
+	lua_pop(L, 1);
+
+	int mask = MAX(singleton->hook_mask, 0);
+	lua_sethook(co, mask ? &godot_lua_hook : nullptr, mask, 0);
+}
+
+void LuaScriptLanguage::_update_breakpoints() {
+	auto &bps = get_script_debugger()->get_breakpoints();
+
+	// The debugger doesn't tell when breakpoints change, a hash of them does.
+	uint32_t hash = hash_djb2_one_32(bps.size());
+#ifdef GODOT_3_X
+	for (const Map<int, Set<StringName>>::Element *E = bps.front(); E; E = E->next()) {
+		for (const Set<StringName>::Element *S = E->get().front(); S; S = S->next()) {
+			hash = hash_djb2_one_32(E->key(), hash);
+			hash = hash_djb2_one_32(S->get().hash(), hash);
+		}
+	}
+#else
+	for (const KeyValue<int, HashSet<StringName>> &E : bps) {
+		for (const StringName &S : E.value) {
+			hash = hash_djb2_one_32(E.key, hash);
+			hash = hash_djb2_one_32(S.hash(), hash);
+		}
+	}
+#endif
+	if (hash == breakpoint_hash) {
+		return;
+	}
+	breakpoint_hash = hash;
+
+	breakpoint_lines.clear();
+	breakpoint_sources.clear();
+	breakpoint_last_source = CharString();
+	breakpoint_last_lines = nullptr;
+#ifdef GODOT_3_X
+	for (const Map<int, Set<StringName>>::Element *E = bps.front(); E; E = E->next()) {
+		for (const Set<StringName>::Element *S = E->get().front(); S; S = S->next()) {
+			set_line_bit(breakpoint_lines, E->key());
+			set_line_bit(breakpoint_sources[S->get()], E->key());
+		}
+	}
+#else
+	for (const KeyValue<int, HashSet<StringName>> &E : bps) {
+		for (const StringName &S : E.value) {
+			set_line_bit(breakpoint_lines, E.key);
+			set_line_bit(breakpoint_sources[S], E.key);
+		}
+	}
+#endif
+}
+
+bool LuaScriptLanguage::is_breakpoint(lua_State *L, lua_Debug *ar) {
+	// Most lines have no breakpoint in any source, they are done without asking Lua for the source.
+	if (!has_line_bit(singleton->breakpoint_lines, ar->currentline)) {
+		return false;
+	}
+	lua_getinfo(L, "S", ar);
+	if (ar->source == nullptr) {
+		return false;
+	}
+	if (strcmp(ar->source, singleton->breakpoint_last_source.get_data()) != 0) {
+		singleton->breakpoint_last_source = CharString(ar->source);
+		singleton->breakpoint_last_lines = singleton->breakpoint_sources.getptr(StringName(ar->source));
+	}
+	return singleton->breakpoint_last_lines && has_line_bit(*singleton->breakpoint_last_lines, ar->currentline);
+}
+
 String LuaScriptLanguage::get_name() const {
 	return LUA_NAME;
 }
@@ -174,6 +359,15 @@ void LuaScriptLanguage::finish() {
 		lua_close(state);
 		state = nullptr;
 	}
+	// After the main state, whose pending worker jobs are waited for when collected.
+	finish_lua_workers();
+#ifndef GODOT_3_X
+	if (gc_monitors_added && Performance::get_singleton()) {
+		Performance::get_singleton()->remove_custom_monitor(LUA_GC_TIME_MONITOR);
+		Performance::get_singleton()->remove_custom_monitor(LUA_GC_HEAP_MONITOR);
+		gc_monitors_added = false;
+	}
+#endif
 }
 
 void LuaScriptLanguage::_get_reserved_words(List<String> *p_words) {
@@ -768,22 +962,251 @@ void LuaScriptLanguage::get_public_annotations(List<MethodInfo> *p_annotations)
 #endif
 
 void LuaScriptLanguage::profiling_start() {
+	for (uint32_t i = 0; i < profile_functions.size(); i++) {
+		ProfileFunction &function = profile_functions[i];
+		ProfileFunction reset;
+		reset.signature = function.signature;
+		reset.named = function.named;
+		function = reset;
+	}
+	profile_stack.clear();
+	profiling = true;
+	_update_hook();
 }
 
 void LuaScriptLanguage::profiling_stop() {
+	profiling = false;
+	profile_stack.clear();
+	_update_hook();
 }
 
-int LuaScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) { // TODO
+int LuaScriptLanguage::profiling_get_accumulated_data(ProfilingInfo *p_info_arr, int p_info_max) {
+	int current = 0;
+	for (uint32_t i = 0; i < profile_functions.size(); i++) {
+		const ProfileFunction &function = profile_functions[i];
+		if (current >= p_info_max) {
+			break;
+		}
+		if (function.call_count == 0) {
+			continue;
+		}
+		p_info_arr[current].signature = function.signature;
+		p_info_arr[current].call_count = function.call_count;
+		p_info_arr[current].total_time = function.total_time;
+		p_info_arr[current].self_time = function.self_time;
+		current++;
+	}
+	return current;
+}
 
-	return -1;
+int LuaScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) {
+	int current = 0;
+	for (uint32_t i = 0; i < profile_functions.size(); i++) {
+		const ProfileFunction &function = profile_functions[i];
+		if (current >= p_info_max) {
+			break;
+		}
+		if (function.last_frame_call_count == 0) {
+			continue;
+		}
+		p_info_arr[current].signature = function.signature;
+		p_info_arr[current].call_count = function.last_frame_call_count;
+		p_info_arr[current].total_time = function.last_frame_total_time;
+		p_info_arr[current].self_time = function.last_frame_self_time;
+		current++;
+	}
+	return current;
 }
 
-int LuaScriptLanguage::profiling_get_frame_data(ProfilingInfo *p_info_arr, int p_info_max) { // TODO
+// Number of calls under the one at level 0, found by bisection like `luaL_traceback` does.
+static int get_stack_depth(lua_State *L) {
+	lua_Debug ar;
+	int valid = 0;
+	int invalid = 1;
+	while (lua_getstack(L, invalid, &ar)) {
+		valid = invalid;
+		invalid *= 2;
+	}
+	while (valid + 1 < invalid) {
+		int mid = (valid + invalid) / 2;
+		if (lua_getstack(L, mid, &ar)) {
+			valid = mid;
+		} else {
+			invalid = mid;
+		}
+	}
+	return valid;
+}
 
-	return -1;
+void LuaScriptLanguage::profile_hook(lua_State *L, lua_Debug *ar) {
+	uint64_t time = OS::get_singleton()->get_ticks_usec();
+	lua_getinfo(L, "S", ar);
+	if (ar->what[0] == 'C') {
+		// Native calls are not tracked, their time counts as self time of the Lua caller.
+		return;
+	}
+
+	int level = get_stack_depth(L);
+	switch (ar->event) {
+		case LUA_HOOKCALL:
+			singleton->_profile_trim(L, level, time);
+			singleton->_profile_enter(L, ar, level, time);
+			break;
+		case LUA_HOOKTAILCALL:
+			// The caller's frame is replaced and will never return.
+			singleton->_profile_trim(L, level + 1, time);
+			singleton->_profile_leave(L, time);
+			singleton->_profile_enter(L, ar, level, time);
+			break;
+		case LUA_HOOKRET:
+			singleton->_profile_trim(L, level + 1, time);
+			singleton->_profile_leave(L, time);
+			break;
+	}
+}
+
+/**
+ * @brief Closes the frames of `L` at `p_level` and deeper: a Lua error unwinds calls without running their return hook
+ */
+void LuaScriptLanguage::_profile_trim(lua_State *L, int p_level, uint64_t p_time) {
+	while (profile_stack.size() && profile_stack[profile_stack.size() - 1].L == L && profile_stack[profile_stack.size() - 1].level >= p_level) {
+		_profile_leave(L, p_time);
+	}
+}
+
+void LuaScriptLanguage::_profile_enter(lua_State *L, lua_Debug *ar, int p_level, uint64_t p_time) {
+	ProfileKey key;
+	key.source = StringName(ar->source);
+	key.line = ar->linedefined;
+
+	uint32_t index;
+	const uint32_t *found = profile_function_map.getptr(key);
+	if (found) {
+		index = *found;
+	} else {
+		index = profile_functions.size();
+		profile_functions.push_back(ProfileFunction());
+		profile_function_map.insert(key, index);
+	}
+
+	ProfileFunction &function = profile_functions[index];
+	if (!function.named) {
+		// Lua only knows names from the call site, functions called from C++ are named by the caller.
+		lua_getinfo(L, "n", ar);
+		String name;
+		if (ar->name) {
+			name = String::utf8(ar->name);
+		} else if (profile_pending_name != StringName()) {
+			name = profile_pending_name;
+		}
+		function.named = !IS_EMPTY(name);
+		function.signature = String::utf8(ar->source) + "::" + itos(ar->linedefined) + "::" + (function.named ? name : String("?"));
+	}
+	profile_pending_name = StringName();
+
+	function.call_count++;
+	function.frame_call_count++;
+
+	ProfileFrame frame;
+	frame.L = L;
+	frame.function = index;
+	frame.level = p_level;
+	frame.start = p_time;
+	profile_stack.push_back(frame);
+}
+
+void LuaScriptLanguage::_profile_leave(lua_State *L, uint64_t p_time) {
+	uint32_t depth = profile_stack.size();
+	if (depth == 0 || profile_stack[depth - 1].L != L) {
+		// Started profiling inside this call, or a coroutine switched: nothing to close.
+		return;
+	}
+
+	const ProfileFrame frame = profile_stack[depth - 1];
+	profile_stack.resize(depth - 1);
+
+	uint64_t total_time = p_time - frame.start;
+	uint64_t self_time = total_time > frame.child_time ? total_time - frame.child_time : 0;
+
+	ProfileFunction &function = profile_functions[frame.function];
+	function.total_time += total_time;
+	function.self_time += self_time;
+	function.frame_total_time += total_time;
+	function.frame_self_time += self_time;
+
+	if (depth > 1) {
+		profile_stack[depth - 2].child_time += total_time;
+	}
+}
+
+void LuaScriptLanguage::_gc_frame() {
+	lua_State *L = state;
+	if (!gc_collecting && lua_gc(L, LUA_GCCOUNT, 0) < gc_threshold) {
+		gc_frame_time = 0;
+		return;
+	}
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	if (gc_mode == GC_MODE_GENERATIONAL) {
+		// A step is a whole young collection, which the generational mode keeps short.
+		lua_gc(L, LUA_GCSTEP, 0);
+		gc_collecting = false;
+	} else {
+		// Past twice the threshold allocations outrun the budget, the cycle is finished at once.
+		bool over_budget = lua_gc(L, LUA_GCCOUNT, 0) > gc_threshold * 2;
+		gc_collecting = true;
+		do {
+			if (lua_gc(L, LUA_GCSTEP, 0)) {
+				gc_collecting = false;
+				break;
+			}
+		} while (over_budget || OS::get_singleton()->get_ticks_usec() - start < gc_frame_budget);
+	}
+	gc_frame_time = OS::get_singleton()->get_ticks_usec() - start;
+
+	if (!gc_collecting) {
+		int live = lua_gc(L, LUA_GCCOUNT, 0);
+		gc_threshold = gc_mode == GC_MODE_GENERATIONAL ? live + live * LUA_GC_GEN_MINOR_MUL / 100 : live * gc_pause / 100;
+	}
+}
+
+double LuaScriptLanguage::_get_gc_frame_time() const {
+	return gc_frame_time / 1000.0;
+}
+
+double LuaScriptLanguage::_get_gc_heap_size() const {
+	return lua_gc(state, LUA_GCCOUNT, 0) + lua_gc(state, LUA_GCCOUNTB, 0) / 1024.0;
 }
 
 void LuaScriptLanguage::frame() {
+#ifndef GODOT_3_X
+	// Performance doesn't exist yet when languages are initialized.
+	if (!gc_monitors_added && Performance::get_singleton()) {
+		Performance::get_singleton()->add_custom_monitor(LUA_GC_TIME_MONITOR, callable_mp(this, &LuaScriptLanguage::_get_gc_frame_time), Vector<Variant>());
+		Performance::get_singleton()->add_custom_monitor(LUA_GC_HEAP_MONITOR, callable_mp(this, &LuaScriptLanguage::_get_gc_heap_size), Vector<Variant>());
+		gc_monitors_added = true;
+	}
+#endif
+	if (gc_frame_budget > 0) {
+		_gc_frame();
+	}
+
+	if (debugging) {
+		// Breakpoints and break requests arrive between frames.
+		update_debug_hook();
+	}
+
+	if (profiling) {
+		for (uint32_t i = 0; i < profile_functions.size(); i++) {
+			ProfileFunction &function = profile_functions[i];
+			function.last_frame_call_count = function.frame_call_count;
+			function.last_frame_total_time = function.frame_total_time;
+			function.last_frame_self_time = function.frame_self_time;
+			function.frame_call_count = 0;
+			function.frame_total_time = 0;
+			function.frame_self_time = 0;
+		}
+	}
 }
 
 bool LuaScriptLanguage::handles_global_class_type(const String &p_type) const {
@@ -837,11 +1260,13 @@ String LuaScriptLanguage::get_indentation() const {
 Error LuaScriptLanguage::compile_script(lua_State *L, const String &path, const char *buffer, size_t size) {
 	int top = lua_gettop(L);
 	int pos = 0;
+	Error error = OK;
 
 	GD_STR_HOLD(res_path, path);
 	int ret = luaL_loadbuffer(L, buffer, size, res_path);
 	if (ret != LUA_OK) {
 		ELog("luaL_loadstring error: %s", lua_tostring(L, -1));
+		error = ERR_PARSE_ERROR;
 		goto ERROR;
 	}
 
@@ -859,9 +1284,11 @@ Error LuaScriptLanguage::compile_script(lua_State *L, const String &path, const
 #endif
 
 	if (godot_lua_xpcall(L, 0, 1) != LUA_OK) {
+		error = ERR_SCRIPT_FAILED;
 		goto ERROR;
 	}
 
+	// A chunk returning no class table is a plain script, not a failure.
 	if (!lua_istable(L, -1))
 		goto ERROR;
 
@@ -885,26 +1312,155 @@ REGISTY:
 	}
 
 ERROR:
+	lua_settop(L, top);
+	return error;
+}
+
+// `.luac` header: magic, Lua version, number format, then the hash, size and modification time of the source the chunk was compiled from.
+#define LUA_BYTECODE_MAGIC "GDLC"
+#define LUA_BYTECODE_HEADER_SIZE 28
+#define LUA_BYTECODE_NUMBER_FORMAT ((uint32_t)(sizeof(lua_Integer) << 8 | sizeof(lua_Number)))
+
+static int lua_bytecode_writer(lua_State *L, const void *p, size_t sz, void *u) {
+	Vector<uint8_t> *bytecode = static_cast<Vector<uint8_t> *>(u);
+	int from = bytecode->size();
+	bytecode->resize(from + sz);
+	memcpy(bytecode->ptrw() + from, p, sz);
+	return 0;
+}
+
+Error LuaScriptLanguage::dump_bytecode(lua_State *L, const String &p_path, const CharString &p_source, bool p_strip, Vector<uint8_t> &r_bytecode) {
+	int top = lua_gettop(L);
+	GD_STR_HOLD(res_path, p_path);
+	if (luaL_loadbuffer(L, p_source.get_data(), p_source.length(), res_path) != LUA_OK) {
+		ELog("compile '%s' error: %s", p_path, lua_tostring(L, -1));
+		lua_settop(L, top);
+		return ERR_PARSE_ERROR;
+	}
+
+	r_bytecode.resize(LUA_BYTECODE_HEADER_SIZE);
+	uint8_t *header = r_bytecode.ptrw();
+	memcpy(header, LUA_BYTECODE_MAGIC, 4);
+	encode_uint32(LUA_VERSION_NUM, header + 4);
+	encode_uint32(LUA_BYTECODE_NUMBER_FORMAT, header + 8);
+	encode_uint32(hash_djb2_buffer((const uint8_t *)p_source.get_data(), p_source.length()), header + 12);
+	encode_uint32(p_source.length(), header + 16);
+	encode_uint64(FileAccess::get_modified_time(p_path), header + 20);
+	lua_dump(L, &lua_bytecode_writer, &r_bytecode, p_strip);
+	lua_settop(L, top);
+
+	// Lua checks its own chunk header too (version, format, size and layout of integers and floats),
+	// loading the dump back makes sure it matches this runtime.
+	const char *chunk = (const char *)r_bytecode.ptr() + LUA_BYTECODE_HEADER_SIZE;
+	if (luaL_loadbufferx(L, chunk, r_bytecode.size() - LUA_BYTECODE_HEADER_SIZE, res_path, "b") != LUA_OK) {
+		ELog("dump '%s' error: %s", p_path, lua_tostring(L, -1));
+		lua_settop(L, top);
+		r_bytecode.clear();
+		return ERR_INVALID_DATA;
+	}
 	lua_settop(L, top);
 	return OK;
 }
 
+bool LuaScriptLanguage::_check_bytecode(const Vector<uint8_t> &p_bytecode, const String &p_source_path, CharString &r_source, bool &r_source_read) {
+	if (p_bytecode.size() <= LUA_BYTECODE_HEADER_SIZE) {
+		return false;
+	}
+	const uint8_t *header = p_bytecode.ptr();
+	if (memcmp(header, LUA_BYTECODE_MAGIC, 4) != 0 || decode_uint32(header + 4) != LUA_VERSION_NUM || decode_uint32(header + 8) != LUA_BYTECODE_NUMBER_FORMAT) {
+		return false;
+	}
+	if (IS_EMPTY(p_source_path)) {
+		return true;
+	}
+
+	// An untouched source is trusted without reading it, a touched one is compared by size then by hash.
+	uint64_t modified_time = FileAccess::get_modified_time(p_source_path);
+	if (modified_time != 0 && modified_time == decode_uint64(header + 20)) {
+		return true;
+	}
+	if (!r_source_read) {
+		Error error;
+		String source = FileAccess::get_file_as_string(p_source_path, &error);
+		if (error != OK) {
+			return false;
+		}
+		r_source = source.utf8();
+		r_source_read = true;
+	}
+	return decode_uint32(header + 16) == (uint32_t)r_source.length() &&
+			decode_uint32(header + 12) == hash_djb2_buffer((const uint8_t *)r_source.get_data(), r_source.length());
+}
+
 Error LuaScriptLanguage::compile_script(lua_State *L, const String &path) {
-	Error error;
-	if (path.ends_with(".luac")) {
-		Vector<uint8_t> source = FileAccess::get_file_as_bytes(path, &error);
-		if (error == OK) {
-			String origin_path = path.get_basename() + ".lua";
-			error = compile_script(L, origin_path, (char *)source.ptr(), source.size());
+	String source_path = path.ends_with(".luac") ? path.get_basename() + ".lua" : path;
+	String bytecode_path = source_path.get_basename() + ".luac";
+
+	Error error = ERR_FILE_NOT_FOUND;
+	CharString source_str;
+	bool source_read = false;
+	bool has_source = FileAccess::exists(source_path);
+
+	// Prefer the bytecode exported with the script, as long as it was compiled from the current source.
+	if (FileAccess::exists(bytecode_path)) {
+		Vector<uint8_t> bytecode = FileAccess::get_file_as_bytes(bytecode_path, &error);
+		if (error == OK && _check_bytecode(bytecode, has_source ? source_path : String(), source_str, source_read)) {
+			const char *chunk = (const char *)bytecode.ptr() + LUA_BYTECODE_HEADER_SIZE;
+			return compile_script(L, source_path, chunk, bytecode.size() - LUA_BYTECODE_HEADER_SIZE);
 		}
-	} else {
-		String source = FileAccess::get_file_as_string(path, &error);
-		if (error == OK) {
-			CharString source_str = source.utf8();
-			error = compile_script(L, path, source_str.get_data(), source_str.length());
+		if (has_source) {
+			WARN_PRINT(vformat("Ignoring stale or incompatible Lua bytecode '%s'.", bytecode_path));
+		} else if (error == OK) {
+			error = ERR_INVALID_DATA;
 		}
 	}
-	return error;
+
+	if (!has_source) {
+		return error;
+	}
+	if (!source_read) {
+		String source = FileAccess::get_file_as_string(source_path, &error);
+		if (error != OK) {
+			return error;
+		}
+		source_str = source.utf8();
+	}
+	return compile_script(L, source_path, source_str.get_data(), source_str.length());
+}
+
+Error LuaScriptLanguage::load_chunk(lua_State *L, const String &p_path, Vector<uint8_t> &r_chunk) {
+	String source_path = p_path.ends_with(".luac") ? p_path.get_basename() + ".lua" : p_path;
+	String bytecode_path = source_path.get_basename() + ".luac";
+
+	Error error = OK;
+	CharString source_str;
+	bool source_read = false;
+	bool has_source = FileAccess::exists(source_path);
+
+	Vector<uint8_t> bytecode;
+	if (FileAccess::exists(bytecode_path)) {
+		bytecode = FileAccess::get_file_as_bytes(bytecode_path, &error);
+		if (error != OK || !_check_bytecode(bytecode, has_source ? source_path : String(), source_str, source_read)) {
+			bytecode.clear();
+		}
+	}
+	if (IS_EMPTY(bytecode)) {
+		if (!has_source) {
+			return ERR_FILE_NOT_FOUND;
+		}
+		if (!source_read) {
+			String source = FileAccess::get_file_as_string(source_path, &error);
+			ERR_FAIL_COND_V_MSG(error != OK, error, vformat("Cannot read Lua script '%s'.", source_path));
+			source_str = source.utf8();
+		}
+		error = dump_bytecode(L, source_path, source_str, false, bytecode);
+		if (error != OK) {
+			return error;
+		}
+	}
+	r_chunk.resize(bytecode.size() - LUA_BYTECODE_HEADER_SIZE);
+	memcpy(r_chunk.ptrw(), bytecode.ptr() + LUA_BYTECODE_HEADER_SIZE, r_chunk.size());
+	return OK;
 }
 
 bool LuaScriptLanguage::_register_luaclass_neasted(lua_State *L, const String &path) {
@@ -937,6 +1493,7 @@ void LuaScriptLanguage::_register_luaclass(lua_State *L, int pos, const String &
 	luatable_rawset(L, pos, "__newindex", &lua_godot_object_newindexer);
 	luatable_rawset(L, pos, "__tostring", &lua_godot_object_tostring);
 	luatable_rawset(L, pos, "emit_signal", &script_emit_signal);
+	set_type_tag(L, pos, LUA_TAG_OBJECT);
 
 	lua_pushstring(L, "!metatable");
 	lua_rawget(L, pos);
@@ -7,6 +7,13 @@
 
 #include "core/object/script_language.h"
 #include "core/os/mutex.h"
+#ifdef GODOT_3_X
+#include "core/hash_map.h"
+#include "core/local_vector.h"
+#else
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#endif
 #include "def_lua.h"
 
 #ifdef TOOLS_ENABLED
@@ -30,6 +37,26 @@ _FORCE_INLINE_ static Variant userdata2variant(void *userdata) {
 	return Variant(*(T *)userdata);
 }
 
+/**
+ * @brief Tells what a table or full userdata wraps, stored raw in its metatable, see `LuaScriptLanguage::get_type_tag`
+ */
+enum LuaTypeTag {
+	LUA_TAG_NONE,
+	LUA_TAG_OBJECT, // Tables holding an Object in `__udata`: object proxies and script instances
+	LUA_TAG_VARIANT, // Full userdata: Variant
+	LUA_TAG_VECTOR2, // Full userdata: LuaValue<Vector2>
+	LUA_TAG_VECTOR3, // Full userdata: LuaValue<Vector3>
+	LUA_TAG_RECT2, // Full userdata: LuaValue<Rect2>
+	LUA_TAG_PACKED_BYTE_ARRAY, // Full userdata: LuaPackedArray<uint8_t>, and so on
+	LUA_TAG_PACKED_INT32_ARRAY,
+	LUA_TAG_PACKED_INT64_ARRAY,
+	LUA_TAG_PACKED_FLOAT32_ARRAY,
+	LUA_TAG_PACKED_FLOAT64_ARRAY,
+	LUA_TAG_PACKED_VECTOR2_ARRAY,
+	LUA_TAG_PACKED_VECTOR3_ARRAY,
+	LUA_TAG_MAX,
+};
+
 class LuaScript;
 
 class LuaScriptLanguage : public ScriptLanguage {
@@ -37,6 +64,7 @@ class LuaScriptLanguage : public ScriptLanguage {
 
 	friend class LuaScript;
 	friend class LuaScriptInstance;
+	friend class LuaScriptBenchmark;
 
 private:
 	Mutex mutex{};
@@ -53,6 +81,16 @@ private:
 	 */
 	int fn_reassign_script;
 
+	/**
+	 * @brief A lua function, reads a property of an instance from its resolved info table
+	 */
+	int fn_get_instance_property;
+
+	/**
+	 * @brief Bumped by every script reload, invalidates the member caches of all scripts
+	 */
+	uint32_t member_cache_version = 1;
+
 	/**
 	 * @brief A lua table, holds all loaded scripts
 	 */
@@ -63,6 +101,16 @@ private:
 	 */
 	int methods;
 
+	/**
+	 * @brief A weak-valued lua table, proxies of Godot Objects by `ObjectID`
+	 */
+	int object_proxies;
+
+	/**
+	 * @brief A weak-keyed lua table, every coroutine created from Lua, so `_update_hook` reaches them
+	 */
+	int coroutines;
+
 	Map<StringName, godot_TypeRegister> registers_map;
 	Map<StringName, udata2var_TypeConvert> udata_to_var_map;
 
@@ -71,8 +119,98 @@ private:
 	Map<StringName, udata2lua_TypeConvert> udata_to_lua_map;
 	Map<StringName, Variant::Type> variant_type_map;
 
+	/**
+	 * @brief Converters to Variant indexed by type tag, the key of the tag in metatables is the address of `type_tag_key`
+	 */
+	lua2godot_TypeConvert tag_converters[LUA_TAG_MAX] = {};
+	static char type_tag_key;
+
 	Object *singleton4lua;
 
+	/**
+	 * @brief Lua functions are identified by the chunk and the line they are defined at.
+	 * The source is interned: the string Lua holds goes away with the chunk, and its address may be reused.
+	 */
+	struct ProfileKey {
+		StringName source;
+		int line = 0;
+
+		bool operator==(const ProfileKey &p_other) const {
+			return source == p_other.source && line == p_other.line;
+		}
+	};
+
+	struct ProfileKeyHasher {
+		static _FORCE_INLINE_ uint32_t hash(const ProfileKey &p_key) {
+			return hash_djb2_one_32(p_key.line, p_key.source.hash());
+		}
+	};
+
+	struct ProfileFunction {
+		StringName signature;
+		bool named = false;
+		uint64_t call_count = 0;
+		uint64_t total_time = 0;
+		uint64_t self_time = 0;
+		uint64_t frame_call_count = 0;
+		uint64_t frame_total_time = 0;
+		uint64_t frame_self_time = 0;
+		uint64_t last_frame_call_count = 0;
+		uint64_t last_frame_total_time = 0;
+		uint64_t last_frame_self_time = 0;
+	};
+
+	struct ProfileFrame {
+		lua_State *L = nullptr;
+		uint32_t function = 0;
+		int level = 0; // Depth of the call in `L`, see `_profile_trim`
+		uint64_t start = 0;
+		uint64_t child_time = 0;
+	};
+
+	/**
+	 * @brief The hook is only installed while debugging or profiling, see `_update_hook`
+	 */
+	bool debugging = false;
+	bool profiling = false;
+	int hook_mask = -1;
+
+	/**
+	 * @brief One bit per line holding a breakpoint: `breakpoint_lines` for any source, then per source.
+	 * Mirrors the breakpoints of the ScriptDebugger, see `_update_breakpoints`
+	 */
+	LocalVector<uint64_t> breakpoint_lines;
+	Map<StringName, LocalVector<uint64_t>> breakpoint_sources;
+	uint32_t breakpoint_hash = 0;
+	CharString breakpoint_last_source;
+	const LocalVector<uint64_t> *breakpoint_last_lines = nullptr;
+	LocalVector<ProfileFunction> profile_functions;
+	HashMap<ProfileKey, uint32_t, ProfileKeyHasher> profile_function_map;
+	LocalVector<ProfileFrame> profile_stack;
+	StringName profile_pending_name;
+
+	enum GCMode {
+		GC_MODE_INCREMENTAL,
+		GC_MODE_GENERATIONAL,
+	};
+
+	/**
+	 * @brief With a `gc_frame_budget` (usec, opt-in), `frame()` steps the collector ahead of Lua, see `_gc_frame`.
+	 * Lua's own collector keeps running as a backstop. A budget of 0 leaves collection to Lua alone.
+	 */
+	GCMode gc_mode = GC_MODE_INCREMENTAL;
+	uint64_t gc_frame_budget = 0;
+	int gc_pause = 200;
+	bool gc_collecting = false;
+	int gc_threshold = 0; // Heap size in KB that starts the next collection.
+	uint64_t gc_frame_time = 0;
+	bool gc_monitors_added = false;
+
+	/**
+	 * @brief Dictionary keys are pushed as native Lua keys instead of strings, math value keys compare by value, see `lua_push_godot_dictionary`
+	 */
+	bool typed_dictionary_keys = false;
+
 #ifndef GODOT_3_X
 	Mutex cache_mutex;
 	/**
@@ -96,6 +234,17 @@ public:
 		return singleton->singleton4lua;
 	}
 
+	_FORCE_INLINE_ static bool has_typed_dictionary_keys() {
+		return singleton->typed_dictionary_keys;
+	}
+
+	/**
+	 * @brief Drops the member caches of all scripts, once a script table changed at runtime
+	 */
+	_FORCE_INLINE_ static void invalidate_member_caches() {
+		singleton->member_cache_version++;
+	}
+
 	///////////////////////////////////////////////////////////////////////////
 	/** USERDATA Handle: Godot Value Type                                   **/
 	///////////////////////////////////////////////////////////////////////////
@@ -148,6 +297,27 @@ public:
 		return elem ? ITER_GET(elem) : nullptr;
 	}
 
+	_LUA_INLINE_ static void set_type_tag(lua_State *L, int metatable, LuaTypeTag tag) {
+		metatable = lua_absindex(L, metatable);
+		lua_pushinteger(L, tag);
+		lua_rawsetp(L, metatable, &type_tag_key);
+	}
+	_LUA_INLINE_ static LuaTypeTag get_type_tag(lua_State *L, int pos) {
+		if (!lua_getmetatable(L, pos)) {
+			return LUA_TAG_NONE;
+		}
+		lua_rawgetp(L, -1, &type_tag_key);
+		auto tag = LuaTypeTag(lua_tointeger(L, -1));
+		lua_pop(L, 2);
+		return tag;
+	}
+	_LUA_INLINE_ static void set_tag_converter(LuaTypeTag tag, lua2godot_TypeConvert converter) {
+		singleton->tag_converters[tag] = converter;
+	}
+	_LUA_INLINE_ static lua2godot_TypeConvert find_tag_converter(LuaTypeTag tag) {
+		return singleton->tag_converters[tag];
+	}
+
 	///////////////////////////////////////////////////////////////////////////
 	/** USERDATA Handle: Godot Variant                                      **/
 	///////////////////////////////////////////////////////////////////////////
@@ -165,25 +335,10 @@ public:
 	static void register_godot_object(lua_State *L, const StringName &class_name);
 	static const bool import_godot_object(lua_State *L, const String &class_name);
 	static void push_godot_object(lua_State *L, Object *obj);
-	static void ref_godot_object(lua_State *L, Object *obj) {
-		lua_createtable(L, 0, 1);
-		if (obj != nullptr) {
-			if (auto ref = Object::cast_to<Reference>(obj)) {
-				// Increase reference count which will decrease when `__gc`.
-				ref->reference();
-				lua_pushlightuserdata(L, obj);
-				//DLog("push Reference: %s %d", obj, ref->reference_get_count());
-			} else {
-				// Use `ObjectID` in lua will be safe, because the object can be delete from anywhere.
-				lua_pushinteger(L, OID_2_INT(obj->get_instance_id()));
-			}
-		} else {
-			lua_pushinteger(L, 0);
-		}
-		lua_setfield(L, -2, K_LUA_UDATA);
-		import_godot_object(L, obj ? obj->get_class_name() : "Object");
-		gdlua_setmetatable(L, -2);
-	}
+	/**
+	 * @brief Pushes the proxy table of `obj`, the same one as long as Lua keeps it alive
+	 */
+	static void ref_godot_object(lua_State *L, Object *obj);
 
 	///////////////////////////////////////////////////////////////////////////
 
@@ -227,6 +382,14 @@ public:
 
 	static Error compile_script(lua_State *L, const String &path, const char *buffer, size_t size);
 	static Error compile_script(lua_State *L, const String &path);
+	/**
+	 * @brief Compiles `p_source` into the content of a `.luac` file: a header binding it to the runtime and to its source, then the chunk from `lua_dump`.
+	 */
+	static Error dump_bytecode(lua_State *L, const String &p_path, const CharString &p_source, bool p_strip, Vector<uint8_t> &r_bytecode);
+	/**
+	 * @brief Compiled chunk of the script at `p_path`, ready for `luaL_loadbufferx` in any state: the exported bytecode if up to date, otherwise compiled with `L`.
+	 */
+	static Error load_chunk(lua_State *L, const String &p_path, Vector<uint8_t> &r_chunk);
 
 	virtual String get_name() const override;
 
@@ -316,15 +479,59 @@ public:
 private:
 	static const StringName &_import_godot_class(lua_State *L, const StringName &class_name);
 	static void _get_reserved_words(List<String> *p_words);
+	/**
+	 * @brief Whether a `.luac` content runs on this runtime and, unless `p_source_path` is empty, was compiled from that source.
+	 * The source is only read when its modification time changed, it is then kept in `r_source` and `r_source_read` is set.
+	 */
+	static bool _check_bytecode(const Vector<uint8_t> &p_bytecode, const String &p_source_path, CharString &r_source, bool &r_source_read);
 	static void _register_luaclass(lua_State *L, int pos, const String &path);
 	static bool _register_luaclass_neasted(lua_State *L, const String &path);
 
+	void _update_hook();
+	void _update_breakpoints();
+	void _gc_frame();
+	double _get_gc_frame_time() const;
+	double _get_gc_heap_size() const;
+	void _profile_enter(lua_State *L, lua_Debug *ar, int p_level, uint64_t p_time);
+	void _profile_leave(lua_State *L, uint64_t p_time);
+	void _profile_trim(lua_State *L, int p_level, uint64_t p_time);
+
 	String get_indentation() const;
 
 	lua_State *_debug_state;
 	Vector<StackInfo> _stack_info;
 
 public:
+	_FORCE_INLINE_ static bool is_debugging() {
+		return singleton->debugging;
+	}
+	_FORCE_INLINE_ static bool is_profiling() {
+		return singleton->profiling;
+	}
+	/**
+	 * @brief Names the next Lua function entered from C++, which the hook can't tell
+	 */
+	_FORCE_INLINE_ static void profile_name_next_call(const StringName &p_name) {
+		singleton->profile_pending_name = p_name;
+	}
+	static void profile_hook(lua_State *L, lua_Debug *ar);
+
+	/**
+	 * @brief Whether a breakpoint is set at the line of the hook event `ar`
+	 */
+	static bool is_breakpoint(lua_State *L, lua_Debug *ar);
+	/**
+	 * @brief Follows the breakpoints and stepping state of the debugger, e.g. once it resumes
+	 */
+	static void update_debug_hook() {
+		singleton->_update_breakpoints();
+		singleton->_update_hook();
+	}
+	/**
+	 * @brief Keeps the hook of the coroutine at `pos` in step with the main state from now on
+	 */
+	static void track_coroutine(lua_State *L, int pos);
+
 	static void breakpoint(lua_State *L) {
 		singleton->_debug_state = L;
 		singleton->_stack_info.clear();
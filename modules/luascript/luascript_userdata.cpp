@@ -12,6 +12,8 @@
 #include "luascript.h"
 #include "luascript_instance.h"
 
+extern void build_godot_member_table(lua_State *L, int metatable, const StringName &class_name);
+
 void LuaScriptLanguage::register_userdata(lua_State *L, const char *class_name) {
 	if (!luaL_getmetatable(L, class_name)) {
 		lua_pop(L, 1);
@@ -38,6 +40,7 @@ void LuaScriptLanguage::register_variant(lua_State *L, Variant::Type type, const
 		gdluaL_newmetatable(L, type_name);
 		luatable_rawset(L, -1, "new", &lua_godot_variant_call);
 		luatable_rawset(L, -1, "__type", (lua_Integer)type);
+		set_type_tag(L, -1, LUA_TAG_VARIANT);
 		luatable_rawset(L, -1, "__call", &lua_godot_variant_call);
 		luatable_rawset(L, -1, "__index", &lua_godot_variant_indexer);
 		luatable_rawset(L, -1, "__newindex", &lua_godot_variant_newindexer);
@@ -134,6 +137,7 @@ void LuaScriptLanguage::register_godot_object(lua_State *L, const StringName &cl
 		luatable_rawset(L, -1, "__tostring", &lua_godot_object_tostring);
 		luatable_rawset(L, -1, "__eq", &lua_godot_object_eq);
 		luatable_rawset(L, -1, "is_instance", &godot_object_is_instance);
+		set_type_tag(L, -1, LUA_TAG_OBJECT);
 
 		VLog("register_userdata_type: %s", class_name);
 
@@ -190,6 +194,8 @@ const StringName &LuaScriptLanguage::_import_godot_class(lua_State *L, const Str
 
 			gdlua_setmetatable(L, -2);
 		}
+		build_godot_member_table(L, -1, class_name);
+		lua_pop(L, 1);
 	}
 	return class_name;
 }
@@ -205,6 +211,45 @@ const bool LuaScriptLanguage::import_godot_object(lua_State *L, const String &cl
 	return false;
 }
 
+static void new_object_proxy(lua_State *L, Object *obj) {
+	lua_createtable(L, 0, 1);
+	if (obj != nullptr) {
+		if (auto ref = Object::cast_to<Reference>(obj)) {
+			// Increase reference count which will decrease when `__gc`.
+			ref->reference();
+			lua_pushlightuserdata(L, obj);
+			//DLog("push Reference: %s %d", obj, ref->reference_get_count());
+		} else {
+			// Use `ObjectID` in lua will be safe, because the object can be delete from anywhere.
+			lua_pushinteger(L, OID_2_INT(obj->get_instance_id()));
+		}
+	} else {
+		lua_pushinteger(L, 0);
+	}
+	lua_setfield(L, -2, K_LUA_UDATA);
+	LuaScriptLanguage::import_godot_object(L, obj ? obj->get_class_name() : "Object");
+	gdlua_setmetatable(L, -2);
+}
+
+void LuaScriptLanguage::ref_godot_object(lua_State *L, Object *obj) {
+	if (obj == nullptr) {
+		new_object_proxy(L, nullptr);
+		return;
+	}
+
+	// `ObjectID`s are not reused, an entry left by a freed object can not be found by another one.
+	// A proxy being finalized is already gone from the weak table, so `__gc` never races with a reuse.
+	lua_Integer id = OID_2_INT(obj->get_instance_id());
+	lua_rawgeti(L, LUA_REGISTRYINDEX, singleton->object_proxies); // proxies
+	if (lua_rawgeti(L, -1, id) != LUA_TTABLE) { // proxies|proxy?
+		lua_pop(L, 1);
+		new_object_proxy(L, obj); // proxies|proxy
+		lua_pushvalue(L, -1);
+		lua_rawseti(L, -3, id);
+	}
+	lua_remove(L, -2); // proxy
+}
+
 void LuaScriptLanguage::push_godot_object(lua_State *L, Object *obj) {
 	if (obj) {
 		if (auto script = Object::cast_to<LuaScript>(obj)) {
@@ -5,7 +5,13 @@
 
 #include "register_types.h"
 
+#ifdef GODOT_3_X
+#include "core/project_settings.h"
+#else
+#include "core/config/project_settings.h"
+#endif
 #include "luascript.h"
+#include "luascript_benchmark.h"
 #include "luascript_language.h"
 #include "luascript_resource_formate_loader.h"
 #include "luascript_resource_formate_saver.h"
@@ -49,6 +55,17 @@ class MODLuaScript : public SpikeModule {
 public:
 	static void servers(bool do_init) {
 		if (do_init) {
+			String gc_mode = "luascript/gc/mode";
+			GLOBAL_DEF(gc_mode, 0);
+			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gc_mode, PROPERTY_HINT_ENUM, "Incremental,Generational"));
+			String gc_frame_budget = "luascript/gc/frame_budget_usec";
+			GLOBAL_DEF(gc_frame_budget, 0);
+			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gc_frame_budget, PROPERTY_HINT_RANGE, "0,16000,1"));
+			String gc_pause = "luascript/gc/pause";
+			GLOBAL_DEF(gc_pause, 200);
+			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gc_pause, PROPERTY_HINT_RANGE, "100,500,1"));
+			GLOBAL_DEF("luascript/dictionary/typed_keys", false);
+
 			GDREGISTER_CLASS(LuaScript);
 			script_language = memnew(LuaScriptLanguage);
 			ScriptServer::register_language(script_language);
@@ -65,6 +82,17 @@ public:
 		}
 	}
 
+#ifdef TOOLS_ENABLED
+	static void scene(bool do_init) {
+		if (do_init) {
+			GDREGISTER_CLASS(LuaScriptBenchmark);
+			if (LuaScriptBenchmark::get_requested_iterations() > 0) {
+				ProjectSettings::get_singleton()->set("application/run/main_loop_type", "LuaScriptBenchmark");
+			}
+		}
+	}
+#endif
+
 #ifdef TOOLS_ENABLED
 	static void editor(bool do_init) {
 		if (do_init) {
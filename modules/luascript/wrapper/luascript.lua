@@ -3,10 +3,11 @@ local LuaScript = {}
 
 local rawget, rawset, getmetatable = rawget, rawset, getmetatable
 
+--- Also returns the table holding the field.
 local function _find_meta_field(mt, k)
     while mt and not rawget(mt, "__native") do
         local v = rawget(mt, k)
-        if v ~= nil then return v end
+        if v ~= nil then return v, mt end
         mt = getmetatable(mt)
     end
 end
@@ -160,34 +161,46 @@ function LuaScript.get_script_member(script, field, flags)
     return exists, value
 end
 
+--- Read property `field` of `instance`, `member` is its info table
+local function _get_instance_property(instance, field, member)
+    if member[1] == nil and member.type then
+        member[1] = new_variant(member.type)
+    end
+
+    local gtype = type(member.get)
+    if gtype == "function" then
+        member.get(instance)
+    elseif gtype == "string" then
+        local getfun = _find_meta_field(instance, member.get)
+        if getfun then getfun(instance) end
+    end
+    local props = rawget(instance, ".props")
+    if props == nil then
+        props = {}
+        rawset(instance, ".props", props)
+    end
+
+    local value = props[field]
+    if value == nil then
+        value = member[1]
+        if type(value) == "table" then
+            value = {}
+            for k, v in pairs(member[1]) do value[k] = v end
+            props[field] = setmetatable(value, getmetatable(member[1]))
+        end
+    end
+    return value
+end
+
+LuaScript.get_instance_property = _get_instance_property
+
 function LuaScript.get_instance_member(instance, field, flags)
     local script = getmetatable(instance)
     local member, is_prop = _internal_get_member(script, instance, field, flags)
     local exists, value = member ~= nil, member
     if exists then
         if is_prop then
-            local gtype = type(member.get)
-            if gtype == "function" then
-                member.get(instance)
-            elseif gtype == "string" then
-                local getfun = _find_meta_field(instance, member.get)
-                if getfun then getfun(instance) end
-            end
-            local props = rawget(instance, ".props")
-            if props == nil then
-                props = {}
-                rawset(instance, ".props", props)
-            end
-
-            value = props[field]
-            if value == nil then
-                value = member[1]
-                if type(value) == "table" then
-                    value = {}
-                    for k, v in pairs(member[1]) do value[k] = v end
-                    props[field] = setmetatable(value, getmetatable(member[1]))
-                end
-            end
+            value = _get_instance_property(instance, field, member)
         else
             if type(member) == "table" then
                 local mt = getmetatable(member)
@@ -208,6 +221,30 @@ function LuaScript.get_instance_member(instance, field, flags)
     return exists, value
 end
 
+--- Resolve `field` against the script chain only, for the member cache of LuaScript.
+--- Functions are read again from the script table holding them, property infos are stable until the script reloads,
+--- anything else has to be looked up on every access.
+---@return number, any @kind (0=none, 1=function, 2=property, 3=dynamic), script table holding the function or property info
+function LuaScript.resolve_script_member(script, instance, field)
+    local member, owner = _find_meta_field(script, field)
+    if member ~= nil then
+        if type(member) == "function" then
+            return 1, owner
+        end
+        return 3
+    end
+
+    local prop = get_prop_info(script, instance, field)
+    if prop then
+        return 2, prop
+    end
+
+    if field == "super" or _find_meta_field(script, "_get") then
+        return 3
+    end
+    return 0
+end
+
 local function rep_udata(o, t)
     local keys = {}
     for k, _ in pairs(o) do
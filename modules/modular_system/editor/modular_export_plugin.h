@@ -55,4 +55,5 @@ public:
 	}
 	virtual PackedStringArray get_files() const override;
 	virtual bool has_file(const String &p_path) const override { return path_remap_file_system.has(p_path) || path_remap_packed_file.has(p_path); }
+	virtual bool is_indexable() const override { return false; }
 };
@@ -8,8 +8,16 @@
 
 #include "spike/version.h"
 
+#ifdef GLES3_ENABLED
+#include "gles3/storage/mesh_storage.h"
+#include "gles3/storage/utilities.h"
+#endif
+
 void EngineUtils::_bind_methods() {
 	ClassDB::bind_static_method(get_class_static(), D_METHOD("get_version_info"), &EngineUtils::get_version_info);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("get_gl_compatibility_render_info"), &EngineUtils::get_gl_compatibility_render_info);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("set_gl_compatibility_skinning_kernel", "kernel"), &EngineUtils::set_gl_compatibility_skinning_kernel);
+	ClassDB::bind_static_method(get_class_static(), D_METHOD("get_gl_compatibility_skinning_kernel"), &EngineUtils::get_gl_compatibility_skinning_kernel);
 }
 
 Dictionary EngineUtils::get_version_info() {
@@ -34,3 +42,36 @@ Dictionary EngineUtils::get_version_info() {
 
 	return dict;
 }
+
+Dictionary EngineUtils::get_gl_compatibility_render_info() {
+	Dictionary dict;
+#ifdef GLES3_ENABLED
+	OPENGL3::Utilities *utilities = OPENGL3::Utilities::get_singleton();
+	if (utilities) {
+		for (int i = 0; i < OPENGL3::Utilities::RENDER_INFO_MAX; i++) {
+			OPENGL3::Utilities::RenderInfo info = OPENGL3::Utilities::RenderInfo(i);
+			dict[OPENGL3::Utilities::get_render_info_name(info)] = utilities->get_render_info(info);
+		}
+	}
+#endif
+	return dict;
+}
+
+void EngineUtils::set_gl_compatibility_skinning_kernel(int p_kernel) {
+#ifdef GLES3_ENABLED
+	OPENGL3::MeshStorage *mesh_storage = OPENGL3::MeshStorage::get_singleton();
+	if (mesh_storage) {
+		mesh_storage->software_skinning_set_kernel(OPENGL3::MeshStorage::SkinningKernel(p_kernel));
+	}
+#endif
+}
+
+int EngineUtils::get_gl_compatibility_skinning_kernel() {
+#ifdef GLES3_ENABLED
+	OPENGL3::MeshStorage *mesh_storage = OPENGL3::MeshStorage::get_singleton();
+	if (mesh_storage) {
+		return mesh_storage->software_skinning_get_kernel();
+	}
+#endif
+	return -1;
+}
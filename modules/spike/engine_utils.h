@@ -17,4 +17,7 @@ protected:
 
 public:
 	static Dictionary get_version_info();
+	static Dictionary get_gl_compatibility_render_info();
+	static void set_gl_compatibility_skinning_kernel(int p_kernel);
+	static int get_gl_compatibility_skinning_kernel();
 };
@@ -49,6 +49,17 @@ public:
 			String gl_skinning = "rendering/gl_compatibility/skinning";
 			GLOBAL_DEF_RST(gl_skinning, 0);
 			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gl_skinning, PROPERTY_HINT_ENUM, "Default,Software Skinning"));
+			String gl_skinning_kernel = "rendering/gl_compatibility/software_skinning/kernel";
+			GLOBAL_DEF(gl_skinning_kernel, 1);
+			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gl_skinning_kernel, PROPERTY_HINT_ENUM, "Scalar,Parallel SIMD"));
+			String gl_skinning_upload_mode = "rendering/gl_compatibility/software_skinning/upload_mode";
+			GLOBAL_DEF(gl_skinning_upload_mode, 1);
+			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gl_skinning_upload_mode, PROPERTY_HINT_ENUM, "Buffer Data,Streaming"));
+			GLOBAL_DEF("rendering/gl_compatibility/threaded_render_list_fill", true);
+			GLOBAL_DEF("rendering/gl_compatibility/auto_instancing", true);
+			String gl_item_reordering_lookahead = "rendering/gl_compatibility/batching/item_reordering_lookahead";
+			GLOBAL_DEF(gl_item_reordering_lookahead, 16);
+			ProjectSettings::get_singleton()->set_custom_property_info(PropertyInfo(Variant::INT, gl_item_reordering_lookahead, PROPERTY_HINT_RANGE, "0,256,1"));
 			DisplayServerUniversal::override_create_func();
 		} else {
 		}